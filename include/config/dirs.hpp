@@ -28,6 +28,7 @@ extern const char kFactoryScenarioIdentifier[];
 struct Directories {
     pn::string root;
 
+    pn::string cache;
     pn::string downloads;
     pn::string registry;
     pn::string replays;
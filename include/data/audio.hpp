@@ -19,6 +19,8 @@
 #ifndef ANTARES_DATA_SNDFILE_HPP_
 #define ANTARES_DATA_SNDFILE_HPP_
 
+#include <stddef.h>
+#include <memory>
 #include <pn/data>
 
 namespace antares {
@@ -29,12 +31,41 @@ struct SoundData {
     int      frequency;
 };
 
+// Decodes audio a piece at a time, so that playback of a long song can begin long before all of
+// it would have been decoded, and need not hold all of it at once.
+class AudioStream {
+  public:
+    AudioStream(int channels, int frequency) : _channels(channels), _frequency(frequency) {}
+    AudioStream(const AudioStream&) = delete;
+    AudioStream& operator=(const AudioStream&) = delete;
+    virtual ~AudioStream() {}
+
+    int channels() const { return _channels; }
+    int frequency() const { return _frequency; }
+
+    // Decodes up to `size` bytes of 16-bit signed LPCM into `out`, and returns the number of
+    // bytes decoded.  Returns 0 only at the end of the stream.
+    virtual size_t read(void* out, size_t size) = 0;
+
+    // Returns to the start of the stream.
+    virtual void rewind() = 0;
+
+  private:
+    const int _channels;
+    const int _frequency;
+};
+
+// Decodes the rest of `stream` at once.
+SoundData read_all(AudioStream* stream);
+
 namespace sndfile {
-SoundData convert(pn::data_view in);
+SoundData                    convert(pn::data_view in);
+std::unique_ptr<AudioStream> stream(pn::data in);
 }  // namespace sndfile
 
 namespace modplug {
-SoundData convert(pn::data_view in);
+SoundData                    convert(pn::data_view in);
+std::unique_ptr<AudioStream> stream(pn::data in);
 }  // namespace modplug
 
 }  // namespace antares
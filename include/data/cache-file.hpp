@@ -0,0 +1,35 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_CACHE_FILE_HPP_
+#define ANTARES_DATA_CACHE_FILE_HPP_
+
+#include <pn/data>
+#include <pn/string>
+
+namespace antares {
+
+// Writes `data` to `path`, creating its directory if needed, so that a reader never maps a
+// partial file.  The data goes to a temporary file in the same directory, named uniquely for this
+// process and call, which is then renamed into place; concurrent writers of the same path don't
+// share a temporary file, and the last rename wins.  Throws on failure.
+void write_cache_file(pn::string_view path, pn::data_view data);
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_CACHE_FILE_HPP_
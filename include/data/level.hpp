@@ -150,6 +150,16 @@ union Level {
 };
 Level level(pn::value_cref x);
 
+// Enough of a level to index it by chapter and show its title in the level list.  level_info()
+// reads these fields from the level's procyon value, which must still be parsed in full; it skips
+// building the level's initials, conditions and briefings.  Use Level::get() for the full level,
+// which is built on first use.
+struct LevelInfo {
+    sfz::optional<int64_t> chapter;
+    pn::string             title;
+};
+LevelInfo level_info(pn::value_cref x);
+
 }  // namespace antares
 
 #endif  // ANTARES_DATA_LEVEL_HPP_
@@ -0,0 +1,96 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2016-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_PLUGIN_CACHE_HPP_
+#define ANTARES_DATA_PLUGIN_CACHE_HPP_
+
+#include <map>
+#include <memory>
+#include <pn/data>
+#include <pn/string>
+#include <pn/value>
+
+#include "lang/memory.hpp"
+
+namespace sfz {
+class mapped_file;
+}  // namespace sfz
+
+namespace antares {
+
+// Compiled form of a plugin's procyon data.
+//
+// Parsing procyon text and merging object templates account for most of the time spent loading
+// a plugin.  The cache holds the result of both, keyed by resource path ("levels/1.pn",
+// "objects/ish/cruiser.pn"), with each value in a compact binary encoding that decodes without
+// any tokenizing or number parsing.  Objects are stored with their templates already merged.
+//
+// The cache is written under `dirs().cache`, in a directory named by `plug.digest`, so a stale
+// cache is never consulted.  Since the cache holds values derived from the data, and not just
+// the data, the cache is also keyed by a `compiler_version`, which the code that derives them
+// bumps when its output changes.  Anything missing from the cache or failing validation is
+// parsed from text as usual.
+class PluginCache {
+  public:
+    class Builder;
+
+    // Maps the cache for `digest`.  Returns nullptr if there is none, if it was written by
+    // another `compiler_version`, or if it is invalid.
+    static std::unique_ptr<PluginCache> open(pn::string_view digest, uint32_t compiler_version);
+
+    // The encoding of a single value, as stored in the cache.  decode() returns false if `data`
+    // is not exactly one valid encoded value.
+    static pn::data encode(pn::value_cref x);
+    static bool     decode(pn::data_view data, pn::value* out);
+
+    ~PluginCache();
+
+    // If `path` is in the cache, decodes its value into `out` and returns true.
+    bool get(pn::string_view path, pn::value* out) const;
+
+    size_t size() const { return _entries.size(); }
+
+  private:
+    PluginCache();
+
+    bool index(pn::string_view digest, uint32_t compiler_version, pn::data_view data);
+
+    std::unique_ptr<sfz::mapped_file>   _file;
+    pn::data                            _owned;
+    std::map<pn::string, pn::data_view> _entries;
+    memory::Charge                      _charge;
+};
+
+class PluginCache::Builder {
+  public:
+    Builder();
+
+    void add(pn::string_view path, pn::value_cref x);
+
+    // Writes the cache for `digest` to disk, and returns it.  Failing to write the cache is not
+    // an error; the returned cache still serves the current session from memory.
+    std::unique_ptr<PluginCache> finish(pn::string_view digest, uint32_t compiler_version);
+
+  private:
+    uint32_t _count;
+    pn::data _entries;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_PLUGIN_CACHE_HPP_
@@ -25,6 +25,7 @@
 
 #include "data/handle.hpp"
 #include "data/info.hpp"
+#include "lang/memory.hpp"
 #include "video/driver.hpp"
 
 namespace zipxx {
@@ -34,18 +35,26 @@ class ZipArchive;
 namespace antares {
 
 class BaseObject;
+class PluginCache;
+class SoundBank;
 union Level;
+struct LevelInfo;
 struct Race;
 
 struct ScenarioGlobals {
     sfz::optional<pn::string>          dir;
     std::unique_ptr<zipxx::ZipArchive> zip;
+    pn::string                         digest;  // hex; keys on-disk caches of derived data
+    std::unique_ptr<PluginCache>       compiled;
+    std::unique_ptr<SoundBank>         sounds;  // loaded on first use by CachedSound
 
     Info                             info;
     std::map<int, pn::string>        chapters;
-    std::map<pn::string, Level>      levels;
+    std::map<pn::string, LevelInfo>  level_index;
+    std::map<pn::string, Level>      levels;  // parsed on demand by Level::get()
     std::map<pn::string, BaseObject> objects;
     std::map<pn::string, Race>       races;
+    memory::Charge                   loaded_charge{memory::PLUGIN};  // of objects and races
 
     Texture splash;
     Texture starmap;
@@ -20,12 +20,14 @@
 #define ANTARES_DATA_RESOURCE_HPP_
 
 #include <stdint.h>
+#include <memory>
 #include <pn/string>
 #include <vector>
 
 namespace antares {
 
 class ArrayPixMap;
+class AudioStream;
 class BaseObject;
 class NatePixTable;
 class Texture;
@@ -33,6 +35,7 @@ struct Info;
 struct InterfaceData;
 struct FontData;
 union Level;
+struct LevelInfo;
 struct Race;
 struct ReplayData;
 struct SoundData;
@@ -40,28 +43,36 @@ struct SpriteData;
 
 class Resource {
   public:
+    // Prepares to load resources from the data currently selected in `plug`.  Called by
+    // PluginInit whenever it switches data, before anything is loaded from the new data.
+    static void mount();
+
     static std::vector<pn::string> list_levels();
     static std::vector<pn::string> list_replays();
+    static std::vector<pn::string> list_sounds();  // from every source, not just the plugin
     static bool                    object_exists(pn::string_view name);
 
-    static FontData                font(pn::string_view name);
-    static Texture                 font_image(pn::string_view name);
-    static Info                    info();
-    static InterfaceData           interface(pn::string_view name);
-    static Level                   level(pn::string_view path);
-    static SoundData               music(pn::string_view name);
-    static BaseObject              object(pn::string_view path);
-    static Race                    race(pn::string_view path);
-    static ReplayData              replay(pn::string_view name);
-    static std::vector<int32_t>    rotation_table();
-    static SoundData               sound(pn::string_view name);
-    static SpriteData              sprite_data(pn::string_view name);
-    static ArrayPixMap             sprite_image(pn::string_view name);
-    static ArrayPixMap             sprite_overlay(pn::string_view name);
-    static std::vector<pn::string> strings(int id);
-    static pn::string              text(int id);
-    static Texture                 texture(pn::string_view name);
-    static Texture                 texture(int16_t id);
+    static FontData                     font(pn::string_view name);
+    static Texture                      font_image(pn::string_view name);
+    static Info                         info();
+    static InterfaceData                interface(pn::string_view name);
+    static Level                        level(pn::string_view path);
+    static LevelInfo                    level_info(pn::string_view path);
+    static SoundData                    music(pn::string_view name);
+    static std::unique_ptr<AudioStream> music_stream(pn::string_view name);
+    static BaseObject                   object(pn::string_view path);
+    static Race                         race(pn::string_view path);
+    static ReplayData                   replay(pn::string_view name);
+    static std::vector<int32_t>         rotation_table();
+    static SoundData                    sound(pn::string_view name);
+    static std::unique_ptr<AudioStream> sound_stream(pn::string_view name);
+    static SpriteData                   sprite_data(pn::string_view name);
+    static ArrayPixMap                  sprite_image(pn::string_view name);
+    static ArrayPixMap                  sprite_overlay(pn::string_view name);
+    static std::vector<pn::string>      strings(int id);
+    static pn::string                   text(int id);
+    static Texture                      texture(pn::string_view name);
+    static Texture                      texture(int16_t id);
 
     Resource() = delete;
 };
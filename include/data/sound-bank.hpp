@@ -0,0 +1,96 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_SOUND_BANK_HPP_
+#define ANTARES_DATA_SOUND_BANK_HPP_
+
+#include <map>
+#include <memory>
+#include <pn/data>
+#include <pn/string>
+
+#include "data/audio.hpp"
+#include "lang/memory.hpp"
+
+namespace sfz {
+class mapped_file;
+}  // namespace sfz
+
+namespace antares {
+
+// Every sound effect available to the plugin, decoded to PCM.
+//
+// The bank is a single file under `dirs().cache`, in a directory named by `plug.digest`, which
+// is memory-mapped so that sounds can be handed to the sound driver without decoding or copying
+// them.  If it is missing or invalid, all sounds are decoded in parallel and a new bank written.
+class SoundBank {
+  public:
+    struct Entry {
+        pn::data_view data;  // 16-bit signed LPCM
+        int           channels;
+        int           frequency;
+    };
+
+    // Maps the bank for `digest`, or builds it.  Failing to write the bank is not an error; the
+    // returned bank still serves the current session from memory.
+    static std::unique_ptr<SoundBank> load(pn::string_view digest);
+
+    ~SoundBank();
+
+    // Returns the sound named `name` (as in Resource::sound()), or nullptr if not in the bank.
+    const Entry* find(pn::string_view name) const;
+
+    size_t size() const { return _entries.size(); }
+
+  private:
+    SoundBank();
+
+    bool index(pn::data_view data);
+
+    std::unique_ptr<sfz::mapped_file> _file;
+    pn::data                          _owned;
+    std::map<pn::string, Entry>       _entries;
+    memory::Charge                    _charge;
+};
+
+// A sound effect's PCM, borrowed from `plug.sounds` if the bank has it, or else decoded now.
+class CachedSound {
+  public:
+    // Loads the bank for the current plugin into `plug.sounds` on first use.  If no valid bank is
+    // on disk, that first call decodes every sound in the plugin before returning.  Sounds are
+    // opened when SoundFX loads them, not when they play.  The fixed sounds are opened by
+    // sys_init(), before PluginInit() sets `plug.digest`, so they are decoded one by one without
+    // the bank; the bank's cost falls in the first level loaded after the plugin is mounted.
+    static CachedSound load(pn::string_view name);
+
+    pn::data_view data() const { return _data; }
+    int           channels() const { return _channels; }
+    int           frequency() const { return _frequency; }
+
+  private:
+    CachedSound() {}
+
+    std::unique_ptr<SoundData> _decoded;  // null if borrowed from the bank
+    pn::data_view              _data;
+    int                        _channels;
+    int                        _frequency;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_SOUND_BANK_HPP_
@@ -0,0 +1,71 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_SPRITE_CACHE_HPP_
+#define ANTARES_DATA_SPRITE_CACHE_HPP_
+
+#include <memory>
+#include <pn/string>
+
+#include "data/sprite-data.hpp"
+#include "drawing/pix-map.hpp"
+#include "lang/memory.hpp"
+
+namespace sfz {
+class mapped_file;
+}  // namespace sfz
+
+namespace antares {
+
+// A sprite's frame metadata, image and overlay, in decoded form.
+//
+// Decoded sprites are kept on disk under `dirs().cache`, in a directory named by `plug.digest`.
+// A cache file holds the frames and raw pixels in native byte order, so it can be memory-mapped
+// and used directly, without touching libpng.  When the plugin data changes, its digest changes
+// too, and sprites are decoded again from PNG and written to the new cache directory.
+class CachedSprite {
+  public:
+    // Loads sprite `name` from the cache if present and valid, or decodes it from the plugin and
+    // then tries to store it in the cache.  Failing to write the cache is not an error.
+    static CachedSprite load(pn::string_view name);
+
+    CachedSprite(CachedSprite&&) = default;
+    CachedSprite& operator=(CachedSprite&&) = default;
+    ~CachedSprite();
+
+    const SpriteData& data() const { return _data; }
+    PixMap&           image() { return *_image; }
+    PixMap&           overlay() { return *_overlay; }
+
+  private:
+    CachedSprite();
+
+    bool map(pn::string_view path);
+    void decode(pn::string_view name);
+    void store(pn::string_view path) const;
+
+    SpriteData                        _data;
+    std::unique_ptr<sfz::mapped_file> _file;
+    std::unique_ptr<PixMap>           _image;
+    std::unique_ptr<PixMap>           _overlay;
+    memory::Charge                    _charge{memory::MAPPED};
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_SPRITE_CACHE_HPP_
@@ -0,0 +1,96 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DRAWING_DISPLAY_LIST_HPP_
+#define ANTARES_DRAWING_DISPLAY_LIST_HPP_
+
+#include <stdint.h>
+#include <algorithm>
+#include <initializer_list>
+#include <pn/string>
+#include <vector>
+
+#include "drawing/color.hpp"
+#include "math/geometry.hpp"
+
+namespace antares {
+
+class Font;
+class Texture;
+
+// A recorded sequence of filled rects, text runs, and pictures.
+//
+// Something that looks the same from frame to frame can record itself once and replay the list
+// each frame, instead of recomputing every border and label.  Replaying submits each run of
+// consecutive rects with a single VideoDriver::fill_rects() call, and each run of consecutive
+// text in one font as a single batch of quads; text is resolved into glyphs when recorded.  Fonts
+// and textures are referenced, not copied, and must outlive the list.
+class DisplayList {
+  public:
+    void clear();
+    bool empty() const { return _ops.empty(); }
+
+    void fill(const Rect& rect, const RgbColor& color);
+    void text(const Font& font, Point at, pn::string_view string, const RgbColor& color);
+    void picture(const Texture& texture, Point at);
+
+    void draw() const;
+
+  private:
+    struct Op {
+        enum Type { RECTS, TEXT, PICTURE } type;
+        size_t         begin, end;  // RECTS: range of _rects and _colors; TEXT: of _glyphs
+        const Font*    font;
+        const Texture* texture;
+        Point          at;
+    };
+
+    struct Glyph {
+        Rect     dest;
+        Rect     source;
+        RgbColor color;
+    };
+
+    std::vector<Op>       _ops;
+    std::vector<Rect>     _rects;
+    std::vector<RgbColor> _colors;
+    std::vector<Glyph>    _glyphs;
+};
+
+// A DisplayList of rects which depend on only a few values.  They are recorded, along with those
+// values, and replayed each frame until the values change.
+struct CachedRects {
+    DisplayList          list;
+    std::vector<int32_t> key;
+
+    // If `new_key` differs from the recorded key, clears `list` and returns true, so that the
+    // caller can record it again.
+    bool update(std::initializer_list<int32_t> new_key) {
+        if ((new_key.size() == key.size()) &&
+            std::equal(new_key.begin(), new_key.end(), key.begin())) {
+            return false;
+        }
+        key.assign(new_key);
+        list.clear();
+        return true;
+    }
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DRAWING_DISPLAY_LIST_HPP_
@@ -24,6 +24,7 @@
 #include <pn/output>
 
 #include "drawing/color.hpp"
+#include "lang/memory.hpp"
 #include "math/geometry.hpp"
 
 namespace antares {
@@ -191,6 +192,8 @@ class ArrayPixMap : public PixMap {
     // stores all rows of pixels contiguously.  This permits the optimization of `fill()` provided
     // above.
     std::unique_ptr<RgbColor[]> _bytes;
+
+    memory::Charge _charge;
 };
 
 // Deserializes an ArrayPixMap from its serialized PNG form.
@@ -47,9 +47,10 @@ class NatePixTable {
 
 class NatePixTable::Frame {
   public:
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame);
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-          Hue hue);
+    // Uploads `image`, the part of sprite sheet `name` at `sprite`, tinted by `overlay` unless
+    // `hue` is gray.  The texture is the only copy of the pixels kept afterwards.
+    Frame(pn::string_view name, int frame, Rect sprite, Rect bounds, const PixMap& image,
+          const PixMap& overlay, Hue hue);
     Frame(Frame&&) = default;
     ~Frame();
 
@@ -57,17 +58,17 @@ class NatePixTable::Frame {
     uint16_t       height() const;
     Size           size() const { return Size{width(), height()}; };
     Point          center() const;
-    const PixMap&  pix_map() const;
     const Texture& texture() const;
 
-  private:
-    void load_image(const PixMap& pix);
-    void load_overlay(const PixMap& pix, Hue hue);
-    void build(pn::string_view name, int frame);
+    // Renders the frame's pixels again from the sprite.  Slow; for tools, not for drawing.
+    ArrayPixMap pix_map() const;
 
-    Rect        _bounds;
-    ArrayPixMap _pix_map;
-    Texture     _texture;
+  private:
+    pn::string _name;
+    Rect       _sprite;
+    Rect       _bounds;
+    Hue        _hue;
+    Texture    _texture;
 };
 
 }  // namespace antares
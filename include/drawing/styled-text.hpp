@@ -20,7 +20,9 @@
 #define ANTARES_DRAWING_STYLED_TEXT_HPP_
 
 #include <map>
+#include <memory>
 #include <pn/string>
+#include <sfz/sfz.hpp>
 #include <utility>
 #include <vector>
 
@@ -57,6 +59,13 @@ struct WrapMetrics {
               side_margin{side_margin},
               line_spacing{line_spacing},
               tab_width{tab_width} {}
+
+    bool operator==(const WrapMetrics& other) const {
+        return (font == other.font) && (width == other.width) &&
+               (side_margin == other.side_margin) && (line_spacing == other.line_spacing) &&
+               (tab_width == other.tab_width);
+    }
+    bool operator!=(const WrapMetrics& other) const { return !(*this == other); }
 };
 
 class StyledText {
@@ -78,6 +87,11 @@ class StyledText {
             pn::string_view text, WrapMetrics metrics, RgbColor fore_color = RgbColor::white(),
             RgbColor back_color = RgbColor::black());
 
+    // Layouts are cached by text, style, colors, and WrapMetrics, so rebuilding the same
+    // StyledText (e.g. each frame) does not parse and wrap it again.  The cache holds fonts by
+    // address, so it must be flushed if they are reloaded.
+    static void flush_layouts();
+
     bool                               empty() const;
     int                                height() const;
     int                                auto_width() const;
@@ -100,6 +114,12 @@ class StyledText {
     int offset(int origin, TextReceiver::Offset offset, TextReceiver::OffsetUnit unit) const;
 
   private:
+    enum Markup {
+        PLAIN,
+        RETRO,
+        INTERFACE,
+    };
+
     enum SpecialChar {
         NONE,
         TAB,
@@ -115,15 +135,44 @@ class StyledText {
                 SpecialChar special, int pict_index, const RgbColor& fore_color,
                 const RgbColor& back_color);
 
-        SpecialChar special;
-        int         pict_index;
-        RgbColor    fore_color;
-        RgbColor    back_color;
-        Rect        bounds;
+        SpecialChar         special;
+        int                 pict_index;
+        RgbColor            fore_color;
+        RgbColor            back_color;
+        Rect                bounds;
+        sfz::optional<Rect> glyph;  // in the font's texture; unset unless drawn as a glyph
+    };
+
+    // Everything determined by the text, colors, and metrics.  Shared between all StyledTexts
+    // built from the same inputs, and never modified once built.
+    struct Layout {
+        Layout(pn::string_view text, WrapMetrics wrap_metrics);
+
+        void rewrap();
+        int  move_word_down(std::map<pn::string::iterator, StyledChar>::iterator it, int v);
+
+        pn::string                                 text;
+        std::map<pn::string::iterator, StyledChar> chars;
+        std::vector<inlinePictType>                inline_picts;
+        std::vector<Texture>                       textures;
+        WrapMetrics                                wrap_metrics;
+        Size                                       auto_size;
     };
+    class LayoutCache;
+    static LayoutCache layout_cache;
+
+    explicit StyledText(std::shared_ptr<const Layout> layout);
+
+    static std::shared_ptr<const Layout> layout(
+            Markup markup, pn::string_view text, WrapMetrics metrics, RgbColor fore_color,
+            RgbColor back_color);
+    static std::unique_ptr<Layout> build_plain(
+            pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color);
+    static std::unique_ptr<Layout> build_retro(
+            pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color);
+    static std::unique_ptr<Layout> build_interface(
+            pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color);
 
-    void rewrap();
-    int  move_word_down(std::map<pn::string::iterator, StyledChar>::iterator it, int v);
     bool is_selected(std::map<pn::string::iterator, StyledChar>::const_iterator it) const;
 
     bool is_line_start(
@@ -139,15 +188,10 @@ class StyledText {
     pn::string::iterator line_up(pn::string::iterator it) const;
     pn::string::iterator line_down(pn::string::iterator it) const;
 
-    pn::string                                                  _text;
-    std::unique_ptr<std::map<pn::string::iterator, StyledChar>> _chars;
-    std::vector<inlinePictType>                                 _inline_picts;
-    std::vector<Texture>                                        _textures;
-    WrapMetrics                                                 _wrap_metrics;
-    std::map<pn::string::iterator, StyledChar>::const_iterator  _until;
-    Size                                                        _auto_size;
-    std::pair<int, int>                                         _selection = {-1, -1};
-    std::pair<int, int>                                         _mark      = {-1, -1};
+    std::shared_ptr<const Layout>                              _layout;  // null if empty
+    std::map<pn::string::iterator, StyledChar>::const_iterator _until;
+    std::pair<int, int>                                        _selection = {-1, -1};
+    std::pair<int, int>                                        _mark      = {-1, -1};
 };
 
 }  // namespace antares
@@ -19,7 +19,10 @@
 #ifndef ANTARES_DRAWING_TEXT_HPP_
 #define ANTARES_DRAWING_TEXT_HPP_
 
+#include <map>
 #include <pn/string>
+#include <unordered_map>
+#include <vector>
 
 #include "drawing/sprite-handling.hpp"
 #include "lang/casts.hpp"
@@ -46,15 +49,27 @@ class Font {
     void draw(Point cursor, pn::string_view string, RgbColor color) const;
     void draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const;
 
+    // The part of `texture` holding the glyph for `rune`.  Valid as long as the font is.
+    const Rect& glyph_rect(pn::rune rune) const {
+        const uint32_t code = rune.value();
+        return (code < kFlatGlyphs) ? _flat_glyphs[code] : other_glyph_rect(code);
+    }
+
     Texture texture;
     int32_t logicalWidth = 0;
     int32_t height       = 0;
     int32_t ascent       = 0;
 
   private:
-    Rect glyph_rect(pn::rune rune) const;
+    static const uint32_t kFlatGlyphs = 256;  // code points looked up in _flat_glyphs
+
+    const Rect& other_glyph_rect(uint32_t code) const;
 
-    std::map<pn::rune, Rect> _glyphs;
+    // Glyphs are resolved when the font is loaded.  Code points below kFlatGlyphs index into
+    // _flat_glyphs, where missing glyphs already hold the fallback; the rest are hashed.
+    std::vector<Rect>                  _flat_glyphs;
+    std::unordered_map<uint32_t, Rect> _other_glyphs;
+    Rect                               _fallback_glyph;
 };
 
 Font font(pn::string_view name);
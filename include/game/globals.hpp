@@ -22,6 +22,7 @@
 #include <queue>
 
 #include "config/keys.hpp"
+#include "data/cash.hpp"
 #include "data/enums.hpp"
 #include "data/handle.hpp"
 #include "data/level.hpp"
@@ -51,6 +52,7 @@ struct miniComputerDataType {
     int32_t                     selectLine;
     Screen                      currentScreen;
     int32_t                     clickLine;
+    sfz::optional<Cash>         buildCash;  // cash when build lines were last dimmed
 };
 
 struct hotKeyType {
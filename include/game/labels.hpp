@@ -20,6 +20,7 @@
 #define ANTARES_GAME_LABELS_HPP_
 
 #include <pn/string>
+#include <sfz/sfz.hpp>
 
 #include "data/base-object.hpp"
 #include "drawing/styled-text.hpp"
@@ -51,6 +52,11 @@ class Label {
     StyledText&       text() { return _text; };
     const StyledText& text() const { return _text; }
 
+    // Sets the label's text, rebuilding it only if `text`, `metrics`, or `color` differ from the
+    // last call.  An unchanged label keeps its reveal, selection, and mark.
+    void set_text(pn::string_view text, WrapMetrics metrics, RgbColor color);
+    void clear_text();
+
     void set_position(int16_t h, int16_t v);
     void set_object(Handle<SpaceObject> object);
     void set_age(ticks age);
@@ -82,6 +88,11 @@ class Label {
     bool  keepOnScreenAnyway = false;  // if not attached to object, keep on screen if it's off
     bool  attachedHintLine   = false;
     Point attachedToWhere;
+
+    // Arguments to the set_text() call that produced `_text`; no metrics if it was set otherwise.
+    pn::string                 _source_text;
+    sfz::optional<WrapMetrics> _source_metrics;
+    RgbColor                   _source_color;
 };
 
 }  // namespace antares
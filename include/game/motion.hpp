@@ -25,6 +25,8 @@
 
 namespace antares {
 
+class SpaceObject;
+
 struct ScaledScreen {
     Scale scale;
     Rect  bounds;
@@ -37,6 +39,10 @@ void ResetMotionGlobals();
 void MoveSpaceObjects(ticks unitsToDo);
 void CollideSpaceObjects();
 
+// Per-object steps of MoveSpaceObjects(), exposed for micro-benchmarks.
+void move_object(SpaceObject* o);
+void bounce_object(SpaceObject* o);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_MOTION_HPP_
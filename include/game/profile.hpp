@@ -0,0 +1,69 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_PROFILE_HPP_
+#define ANTARES_GAME_PROFILE_HPP_
+
+#include <stdint.h>
+#include <pn/fwd>
+#include <vector>
+
+#include "lang/trace.hpp"
+
+namespace antares {
+
+// Time spent per major tick in each subsystem of the game loop, gathered from trace events (see
+// lang/trace.hpp).  A tick is numbered by `g.time / kMajorTick` when it started, and includes
+// all minor ticks up to and including the next major tick, as well as any frames drawn before
+// the next tick starts.
+class TickProfile {
+  public:
+    enum Subsystem {
+        MOVEMENT,
+        COLLISION,
+        LOCALITY,
+        AI_THINK,
+        ACTIONS,
+        CONDITIONS,
+        LABELS,
+        MINICOMPUTER,
+        RENDERING,
+        SUBSYSTEM_COUNT,
+    };
+
+    struct Tick {
+        int64_t number;
+        int64_t total;                      // nanoseconds
+        int64_t subsystem[SUBSYSTEM_COUNT];  // nanoseconds
+        bool    ran[SUBSYSTEM_COUNT];
+    };
+
+    explicit TickProfile(const std::vector<trace::Event>& events);
+
+    const std::vector<Tick>& ticks() const { return _ticks; }
+
+    // Prints p50/p99/max per subsystem and overall, followed by the `worst` slowest ticks.
+    void print(pn::output_view out, int worst = 10) const;
+
+  private:
+    std::vector<Tick> _ticks;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_PROFILE_HPP_
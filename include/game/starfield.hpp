@@ -71,6 +71,7 @@ class Starfield {
   private:
     scrollStarType _stars[kScrollStarNum + kSparkStarNum];
     int32_t        _last_clip_bottom;
+    int32_t        _spark_count;  // sparks with speed != kNoStar
     bool           _warp_stars;
 };
 
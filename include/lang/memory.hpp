@@ -0,0 +1,94 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_MEMORY_HPP_
+#define ANTARES_LANG_MEMORY_HPP_
+
+#include <stdint.h>
+#include <pn/fwd>
+
+// Accounting of the large, long-lived allocations, by the kind of data they hold.  This is not
+// an allocator: owners report what they hold, usually through a `Charge` member that follows the
+// lifetime of the storage it describes.
+//
+//     class ArrayPixMap {
+//         ...
+//         std::unique_ptr<RgbColor[]> _bytes;
+//         memory::Charge              _charge{memory::PIXMAPS};
+//     };
+//
+// Counts are approximate where the real size is hidden (e.g. in a driver or a procyon tree), and
+// exclude allocator overhead.  Loaded plugin objects are counted by their shallow size, without
+// the strings, vectors and maps they own.  Files mapped into memory are counted apart, as
+// MAPPED: they are backed by the file, not the heap, and only resident as their pages are read.
+namespace antares {
+namespace memory {
+
+enum Tag {
+    PIXMAPS,   // decoded pixels held on the CPU
+    TEXTURES,  // pixels uploaded to the video driver
+    SOUNDS,    // samples uploaded to the sound driver, or a sound bank built in memory
+    PLUGIN,    // plugin cache built in memory, and loaded plugin objects (shallow)
+    PROCYON,   // procyon values retained after loading
+    GAME,      // game state tables
+    MAPPED,    // cache files mapped into memory
+    TAG_COUNT,
+};
+
+struct Usage {
+    int64_t current;  // bytes
+    int64_t peak;     // bytes
+};
+
+// Adds `bytes` (which may be negative) to the count for `tag`.  Thread-safe.
+void charge(Tag tag, int64_t bytes);
+
+Usage usage(Tag tag);
+
+// Prints current and peak usage for each tag, and their total.
+void print(pn::output_view out);
+
+// Approximates the heap storage owned by a procyon value, including its children.
+int64_t size_of(pn::value_cref x);
+
+// Holds a count of bytes against a tag until it is destroyed or reset.  Moving a Charge moves
+// the count, so that a movable owner may simply hold one as a member.
+class Charge {
+  public:
+    explicit Charge(Tag tag, int64_t bytes = 0) : _tag(tag), _bytes(bytes) {
+        charge(_tag, _bytes);
+    }
+    Charge(const Charge&) = delete;
+    Charge(Charge&& other) : _tag(other._tag), _bytes(other._bytes) { other._bytes = 0; }
+    Charge& operator=(const Charge&) = delete;
+    Charge& operator=(Charge&& other);
+    ~Charge() { charge(_tag, -_bytes); }
+
+    int64_t bytes() const { return _bytes; }
+    void    reset(int64_t bytes);
+    void    swap(Charge& other);
+
+  private:
+    Tag     _tag;
+    int64_t _bytes;
+};
+
+}  // namespace memory
+}  // namespace antares
+
+#endif  // ANTARES_LANG_MEMORY_HPP_
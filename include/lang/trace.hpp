@@ -0,0 +1,110 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_TRACE_HPP_
+#define ANTARES_LANG_TRACE_HPP_
+
+#include <stdint.h>
+#include <atomic>
+#include <pn/fwd>
+#include <vector>
+
+// Scoped timing instrumentation, written out in Chrome's trace-event format.  Open the output in
+// chrome://tracing or any other viewer of that format; nothing is sent anywhere.
+//
+//     void MoveSpaceObjects(ticks unitsToDo) {
+//         ANTARES_TRACE_SCOPE("MoveSpaceObjects");
+//         ...
+//     }
+//
+// Scopes cost one relaxed atomic load when not recording.  Building with `antares_trace = false`
+// removes them entirely.
+#ifndef ANTARES_TRACE
+#define ANTARES_TRACE 0
+#endif
+
+namespace antares {
+namespace trace {
+
+const int64_t kNoArg = INT64_MIN;
+
+struct Event {
+    const char* name;   // must have static storage duration
+    int64_t     begin;  // nanoseconds since the process started
+    int64_t     end;    // nanoseconds since the process started
+    int64_t     arg;    // kNoArg if none
+    int         thread;
+};
+
+// True if this build includes trace scopes.
+constexpr bool enabled() { return ANTARES_TRACE; }
+
+// Starts or stops recording.  Recording is cumulative: events recorded before stop() are kept,
+// and start() after stop() appends to them.
+void start();
+void stop();
+
+// Returns every event recorded so far, on all threads, ordered by thread and then by end time.
+// May be called while recording; events still being recorded are not included.
+std::vector<Event> events();
+
+// Writes recorded events as a Chrome trace-event JSON object.
+void write(pn::output_view out);
+
+extern std::atomic<bool> recording;
+
+class Scope {
+  public:
+    explicit Scope(const char* name, int64_t arg = kNoArg)
+            : _name(recording.load(std::memory_order_relaxed) ? name : nullptr),
+              _arg(arg),
+              _begin(_name ? now() : 0) {}
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope() {
+        if (_name) {
+            record(_name, _begin, now(), _arg);
+        }
+    }
+
+  private:
+    static int64_t now();
+    static void    record(const char* name, int64_t begin, int64_t end, int64_t arg);
+
+    const char* const _name;
+    const int64_t     _arg;
+    const int64_t     _begin;
+};
+
+}  // namespace trace
+}  // namespace antares
+
+#define ANTARES_TRACE_CONCAT_(a, b) a##b
+#define ANTARES_TRACE_CONCAT(a, b) ANTARES_TRACE_CONCAT_(a, b)
+
+#if ANTARES_TRACE
+#define ANTARES_TRACE_SCOPE(name) \
+    ::antares::trace::Scope ANTARES_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define ANTARES_TRACE_SCOPE_ARG(name, arg) \
+    ::antares::trace::Scope ANTARES_TRACE_CONCAT(trace_scope_, __LINE__)(name, arg)
+#else
+#define ANTARES_TRACE_SCOPE(name) static_cast<void>(0)
+#define ANTARES_TRACE_SCOPE_ARG(name, arg) static_cast<void>(0)
+#endif
+
+#endif  // ANTARES_LANG_TRACE_HPP_
@@ -33,8 +33,9 @@ class Sound {
 
     virtual ~Sound() {}
 
-    virtual void play(uint8_t volume) = 0;
-    virtual void loop(uint8_t volume) = 0;
+    // `pan` runs from -127 (left only) through 0 (centered) to 127 (right only).
+    virtual void play(uint8_t volume, int8_t pan) = 0;
+    virtual void loop(uint8_t volume)             = 0;
 };
 
 class SoundChannel {
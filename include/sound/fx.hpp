@@ -21,6 +21,9 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <memory>
+#include <pn/string>
 #include <vector>
 
 #include "data/handle.hpp"
@@ -29,6 +32,8 @@
 
 namespace antares {
 
+class Sound;
+
 const int32_t kMaxVolumePreference = 8;
 
 class SoundFX {
@@ -67,19 +72,22 @@ class SoundFX {
     void cloak_off_at(Handle<SpaceObject> object);
 
   private:
-    struct smartSoundHandle;
     struct smartSoundChannel;
 
+    bool coalesced(pn::string_view id, uint8_t amplitude);
+    int  instances(pn::string_view id);
     bool same_sound_channel(int& channel, pn::string_view id, uint8_t amplitude, uint8_t priority);
     bool quieter_channel(int& channel, uint8_t amplitude);
     bool lower_priority_channel(int& channel, uint8_t priority);
     bool oldest_available_channel(int& channel);
     bool best_channel(
-            int& channel, pn::string_view sound_id, uint8_t amplitude, usecs persistence,
-            uint8_t priority);
+            int& channel, pn::string_view sound_id, uint8_t amplitude, uint8_t priority);
+    void start(
+            pn::string_view id, uint8_t amplitude, usecs persistence, uint8_t priority,
+            int8_t pan);
 
-    std::vector<smartSoundHandle>  sounds;
-    std::vector<smartSoundChannel> channels;
+    std::map<pn::string, std::unique_ptr<Sound>> sounds;
+    std::vector<smartSoundChannel>               channels;
 };
 
 }  // namespace antares
@@ -0,0 +1,83 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_SOUND_MIX_DRIVER_HPP_
+#define ANTARES_SOUND_MIX_DRIVER_HPP_
+
+#include <chrono>
+#include <memory>
+#include <pn/output>
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "math/units.hpp"
+#include "sound/driver.hpp"
+
+namespace antares {
+
+// Mixes every channel in software, without a sound device, and optionally writes the result to a
+// WAV file.  Mixing follows the video driver's clock rather than a real one, so the output lines
+// up sample-for-sample with the simulation no matter how fast it runs.
+class MixSoundDriver : public SoundDriver {
+  public:
+    static const int kSampleRate = 44100;  // 16-bit stereo
+
+    // If `path` is nullopt, the mix is discarded (useful to measure the cost of mixing).
+    MixSoundDriver(sfz::optional<pn::string_view> path);
+    ~MixSoundDriver();
+
+    virtual std::unique_ptr<SoundChannel> open_channel();
+    virtual std::unique_ptr<Sound>        open_sound(pn::string_view path);
+    virtual std::unique_ptr<Sound>        open_music(pn::string_view path);
+    virtual void                          set_global_volume(uint8_t volume);
+
+    // Mixes up to `time`.  Called whenever a channel changes, with the video driver's now(), and
+    // by the owner once more at the end, since the video driver may be gone by then.
+    void advance(wall_time time);
+
+    // Completes the WAV file, if any.  Throws if it can't be written.  The destructor calls it
+    // too, but can only discard its errors.
+    void close();
+
+    int64_t                  frames() const { return _frames; }
+    std::chrono::nanoseconds mix_time() const { return _mix_time; }
+
+  private:
+    class MixChannel;
+    class MixMusic;
+    class MixSound;
+    struct Voice;
+
+    void start(std::unique_ptr<Voice> voice);
+    void mix(int64_t count);
+
+    pn::string                          _wav_path;
+    std::unique_ptr<pn::output>         _wav;
+    int64_t                             _frames;  // mixed so far
+    int                                 _global_volume;
+    std::vector<std::unique_ptr<Voice>> _voices;  // indexed by channel
+    int                                 _active_channel;
+    std::vector<int32_t>                _accum;
+    std::vector<int16_t>                _out;
+    std::chrono::nanoseconds            _mix_time;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_SOUND_MIX_DRIVER_HPP_
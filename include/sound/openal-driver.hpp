@@ -19,6 +19,8 @@
 #ifndef ANTARES_SOUND_OPENAL_DRIVER_HPP_
 #define ANTARES_SOUND_OPENAL_DRIVER_HPP_
 
+#include <mutex>
+
 #include "sound/driver.hpp"
 
 #ifdef __APPLE__
@@ -45,11 +47,17 @@ class OpenAlSoundDriver : public SoundDriver {
 
   private:
     class OpenAlChannel;
+    class OpenAlMusic;
     class OpenAlSound;
+    class Streamer;
 
     ALCcontext*    _context;
     ALCdevice*     _device;
     OpenAlChannel* _active_channel;
+
+    // Held around every AL call after construction.  Music is refilled on a worker thread, and AL
+    // error state belongs to the context, so without it one thread could read another's errors.
+    mutable std::mutex _al_mutex;
 };
 
 }  // namespace antares
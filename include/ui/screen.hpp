@@ -81,6 +81,7 @@ class InterfaceScreen : public Card {
     Key                                  _key_pressed     = Key::NONE;
     Gamepad::Button                      _gamepad_pressed = Gamepad::Button::NONE;
     Cursor                               _cursor;
+    mutable sfz::optional<Rect>          _widget_bounds;  // computed on first draw
 };
 
 }  // namespace antares
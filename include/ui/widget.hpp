@@ -19,15 +19,18 @@
 #ifndef ANTARES_UI_WIDGET_HPP_
 #define ANTARES_UI_WIDGET_HPP_
 
+#include <memory>
 #include <vector>
 
 #include "data/interface.hpp"
+#include "drawing/display-list.hpp"
 #include "drawing/interface.hpp"
 #include "math/geometry.hpp"
 #include "video/driver.hpp"
 
 namespace antares {
 
+class StyledText;
 class TabBox;
 
 class Widget {
@@ -45,12 +48,26 @@ class Widget {
 
     virtual void activate();
     virtual void deactivate();
-    virtual void draw(Point origin, InputMode mode) const = 0;
-    virtual Rect inner_bounds() const                     = 0;
-    virtual Rect outer_bounds() const                     = 0;
+    virtual void draw(Point origin, InputMode mode) const;
+    virtual Rect inner_bounds() const = 0;
+    virtual Rect outer_bounds() const = 0;
 
     virtual std::vector<const Widget*> children() const;
     virtual std::vector<Widget*>       children();
+
+  protected:
+    // The default draw() replays what record() last recorded, and records again only when the
+    // origin, input mode, or state() changes.  state() should change whenever anything else that
+    // record() depends on does; widgets that always look the same can leave it at 0.
+    virtual uint64_t state() const;
+    virtual void     record(DisplayList* list, Point origin, InputMode mode) const;
+
+  private:
+    mutable DisplayList _display;
+    mutable bool        _display_valid = false;
+    mutable Point       _display_origin;
+    mutable InputMode   _display_mode;
+    mutable uint64_t    _display_state = 0;
 };
 
 class BoxRect : public Widget {
@@ -62,13 +79,15 @@ class BoxRect : public Widget {
     Hue            hue() const { return _hue; }
     InterfaceStyle style() const { return _style; }
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    void record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
-    void draw_labeled_box(Point origin) const;
-    void draw_plain_rect(Point origin) const;
+    void record_labeled_box(DisplayList* list, Point origin) const;
+    void record_plain_rect(DisplayList* list, Point origin) const;
 
     Rect                      _inner_bounds;
     sfz::optional<int64_t>    _id;
@@ -91,11 +110,12 @@ class TextRect : public Widget {
     Rect outer_bounds() const override;
 
   private:
-    Rect                      _inner_bounds;
-    sfz::optional<int64_t>    _id;
-    sfz::optional<pn::string> _text;
-    Hue                       _hue   = Hue::GRAY;
-    InterfaceStyle            _style = InterfaceStyle::LARGE;
+    Rect                                _inner_bounds;
+    sfz::optional<int64_t>              _id;
+    sfz::optional<pn::string>           _text;
+    Hue                                 _hue   = Hue::GRAY;
+    InterfaceStyle                      _style = InterfaceStyle::LARGE;
+    mutable std::unique_ptr<StyledText> _styled_text;  // wrapped on first draw
 };
 
 class PictureRect : public Widget {
@@ -104,10 +124,12 @@ class PictureRect : public Widget {
 
     sfz::optional<int64_t> id() const override { return _id; }
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    void record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     Rect                   _inner_bounds;
     sfz::optional<int64_t> _id;
@@ -139,6 +161,8 @@ class Button : public Widget {
   protected:
     Button(const ButtonData& data);
 
+    uint64_t state() const override;
+
   private:
     sfz::optional<int64_t> _id;
     pn::string             _label;
@@ -162,10 +186,12 @@ class PlainButton : public Button {
     void action() override;
     bool enabled() const override;
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    void record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     Rect   _inner_bounds;
     Action _action;
@@ -187,10 +213,13 @@ class CheckboxButton : public Button {
     bool         enabled() const override;
     virtual void action() override;
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    uint64_t state() const override;
+    void     record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     Rect  _inner_bounds;
     Value _value;
@@ -204,10 +233,12 @@ class RadioButton : public Button {
     bool& on() { return _on; }
     bool  enabled() const override { return false; }
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    void record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     Rect _inner_bounds;
     bool _on = false;
@@ -224,10 +255,13 @@ class TabButton : public Button {
     bool                                        enabled() const override { return true; }
     virtual void                                action() override;
 
-    void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+  protected:
+    uint64_t state() const override;
+    void     record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     TabBox*                              _parent = nullptr;
     Rect                                 _inner_bounds;
@@ -258,6 +292,9 @@ class TabBox : public Widget {
 
     void select(const TabButton& tab);
 
+  protected:
+    void record(DisplayList* list, Point origin, InputMode mode) const override;
+
   private:
     template <typename MaybeConstWidget>
     std::vector<MaybeConstWidget*> children() const;
@@ -31,6 +31,7 @@
 namespace antares {
 
 class Card;
+class DisplayList;
 class KeyMap;
 class PixMap;
 class Texture;
@@ -59,6 +60,9 @@ class VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color)           = 0;
     virtual void    draw_plus(const Rect& rect, const RgbColor& color)              = 0;
 
+    // Fills `count` rects, in order, as if with Rects::fill().
+    virtual void fill_rects(const Rect* rects, const RgbColor* colors, size_t count);
+
   private:
     friend class Points;
     friend class Lines;
@@ -213,8 +217,12 @@ class Lines {
 class Rects {
   public:
     Rects();
+    explicit Rects(DisplayList* list);  // records fills into `list` instead of drawing them
     ~Rects();
     void fill(const Rect& rect, const RgbColor& color) const;
+
+  private:
+    DisplayList* const _list;
 };
 
 class Quads {
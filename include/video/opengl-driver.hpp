@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include <map>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -64,6 +65,7 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual void    draw_triangle(const Rect& rect, const RgbColor& color);
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
     virtual void    draw_plus(const Rect& rect, const RgbColor& color);
+    virtual void    fill_rects(const Rect* rects, const RgbColor* colors, size_t count);
 
     virtual void*   get_proc_address(const char* proc_name) const;
 
@@ -115,6 +117,8 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual void end_rects();
     virtual void batch_rect(const Rect& rect, const RgbColor& color);
 
+    void draw_batch(uint32_t mode);
+
     Random _static_seed;
 
     Uniforms _uniforms;
@@ -124,6 +128,9 @@ class OpenGlVideoDriver : public VideoDriver {
     std::map<size_t, Texture> _pluses;
 
     uint32_t _vbuf[3];
+
+    std::vector<float>   _batch_vertices;  // x, y
+    std::vector<uint8_t> _batch_colors;    // r, g, b, a
 };
 
 }  // namespace antares
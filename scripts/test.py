@@ -27,6 +27,7 @@ WINE_TESTS = [
     "editable-text-test",
     "fixed-test",
     "object-data",
+    "plugin-cache-test",
     "shapes",
     "tint",
 ]
@@ -144,6 +145,7 @@ def main():
         (unit_test, opts, queue, "color-test"),
         (unit_test, opts, queue, "editable-text-test"),
         (unit_test, opts, queue, "fixed-test"),
+        (unit_test, opts, queue, "plugin-cache-test"),
         (data_test, opts, queue, "build-pix", ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
@@ -0,0 +1,323 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <algorithm>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "data/replay.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/action.hpp"
+#include "game/admiral.hpp"
+#include "game/condition.hpp"
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/level.hpp"
+#include "game/messages.hpp"
+#include "game/motion.hpp"
+#include "game/non-player-ship.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "lang/exception.hpp"
+#include "math/units.hpp"
+#include "sound/driver.hpp"
+#include "ui/card.hpp"
+#include "video/text-driver.hpp"
+
+using std::vector;
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+using std::chrono::steady_clock;
+
+struct Scenario {
+    int32_t chapter;
+    int32_t seed;
+};
+
+struct Options {
+    sfz::optional<pn::string> plugin;
+    vector<Scenario>          scenarios;
+    int32_t                   seed   = 1;
+    int                       warmup = 600;
+    int                       ticks  = 1200;
+    int                       repeat = 5;
+};
+
+enum Phase {
+    MOVEMENT,
+    COLLISION,
+    AI_THINK,
+    ACTIONS,
+    CONDITIONS,
+    PHASE_COUNT,
+};
+
+const char* const kPhaseNames[PHASE_COUNT] = {
+        "movement", "collision", "ai", "actions", "conditions",
+};
+
+struct Run {
+    int64_t total = 0;  // nanoseconds
+    int64_t phase[PHASE_COUNT] = {};
+};
+
+int64_t since(steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start)
+            .count();
+}
+
+// Advances the simulation by one major tick, as GamePlay::fire_timer() does when no player is
+// at the controls.  If `run` is non-null, adds the time spent in each phase to it.
+void tick(Run* run) {
+    const steady_clock::time_point start = steady_clock::now();
+    steady_clock::time_point       t     = start;
+
+    auto lap = [run, &t](Phase p) {
+        if (run) {
+            run->phase[p] += since(t);
+        }
+        t = steady_clock::now();
+    };
+
+    g.time += kMajorTick;
+    MoveSpaceObjects(kMajorTick);
+    lap(MOVEMENT);
+    NonplayerShipThink();
+    AdmiralThink();
+    lap(AI_THINK);
+    execute_action_queue();
+    lap(ACTIONS);
+    CollideSpaceObjects();
+    lap(COLLISION);
+    if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
+        CheckLevelConditions();
+    }
+    lap(CONDITIONS);
+    CullSprites();
+    Vectors::cull();
+
+    if (run) {
+        run->total += since(start);
+    }
+}
+
+// Sets up `scenario` from scratch, so that every repetition simulates exactly the same ticks.
+void start(const Scenario& scenario) {
+    g.random.seed = scenario.seed;
+    LoadState s   = start_construct_level(*Level::get(scenario.chapter));
+    while (!s.done) {
+        construct_level(&s);
+    }
+}
+
+int64_t median(vector<int64_t> v) {
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+int64_t per_second(int count, int64_t ns) { return ns ? ((count * 1000000000LL) / ns) : 0; }
+
+void print(const Options& opts, const Scenario& scenario, const vector<Run>& runs) {
+    vector<int64_t> totals;
+    for (const Run& r : runs) {
+        totals.push_back(r.total);
+    }
+    const auto fastest = std::min_element(totals.begin(), totals.end());
+    const auto slowest = std::max_element(totals.begin(), totals.end());
+
+    pn::out.write("{");
+    pn::out.format(
+            "\"chapter\":{0},\"level\":\"{1}\",\"seed\":{2},\"warmup\":{3},\"ticks\":{4},"
+            "\"repeat\":{5}",
+            scenario.chapter, plug.chapters[scenario.chapter], scenario.seed, opts.warmup,
+            opts.ticks, opts.repeat);
+    pn::out.write(",\"ticks_per_sec\":{");
+    pn::out.format(
+            "\"median\":{0},\"min\":{1},\"max\":{2}", per_second(opts.ticks, median(totals)),
+            per_second(opts.ticks, *slowest), per_second(opts.ticks, *fastest));
+    pn::out.write("},\"ns_per_tick\":{");
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        vector<int64_t> times;
+        for (const Run& r : runs) {
+            times.push_back(r.phase[p]);
+        }
+        pn::out.format(
+                "{0}\"{1}\":{2}", p ? "," : "", kPhaseNames[p], median(times) / opts.ticks);
+    }
+    pn::out.write("}}\n");
+}
+
+class BenchMaster : public Card {
+  public:
+    BenchMaster(Options opts) : _opts(std::move(opts)) {}
+
+    virtual void become_front() {
+        init();
+        if (_opts.scenarios.empty()) {
+            for (const auto& kv : plug.chapters) {
+                _opts.scenarios.push_back(Scenario{kv.first, _opts.seed});
+            }
+        }
+        for (const Scenario& scenario : _opts.scenarios) {
+            if (plug.chapters.find(scenario.chapter) == plug.chapters.end()) {
+                throw std::runtime_error(pn::format("no chapter {0}", scenario.chapter).c_str());
+            }
+            vector<Run> runs;
+            for (int i = 0; i < _opts.repeat; ++i) {
+                start(scenario);
+                for (int j = 0; j < _opts.warmup; ++j) {
+                    tick(nullptr);
+                }
+                runs.emplace_back();
+                for (int j = 0; j < _opts.ticks; ++j) {
+                    tick(&runs.back());
+                }
+            }
+            print(_opts, scenario, runs);
+        }
+        stack()->pop(this);
+    }
+
+  private:
+    void init() {
+        init_globals();
+        sys_init();
+        Label::init();
+        Messages::init();
+        InstrumentInit();
+        SpriteHandlingInit();
+        PluginInit(
+                _opts.plugin.has_value() ? sfz::make_optional<pn::string_view>(*_opts.plugin)
+                                         : sfz::nullopt);
+        SpaceObjectHandlingInit();  // MUST be after PluginInit()
+        Admiral::init();
+        Vectors::init();
+    }
+
+    Options _opts;
+};
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] [REPLAY...]"
+            "\n"
+            "\n  Measures simulation ticks per second."
+            "\n  Prints one JSON object per line for each level benchmarked."
+            "\n"
+            "\n  arguments:"
+            "\n    REPLAY               benchmark the level and seed of this replay"
+            "\n"
+            "\n  options:"
+            "\n    -p, --plugin=PATH    load this plugin (default: factory scenario)"
+            "\n    -l, --level=CHAPTER  benchmark this chapter (default: all)"
+            "\n    -s, --seed=SEED      random seed for --level (default: 1)"
+            "\n    -w, --warmup=TICKS   untimed major ticks before measuring (default: 600)"
+            "\n    -t, --ticks=TICKS    timed major ticks per repetition (default: 1200)"
+            "\n    -r, --repeat=COUNT   repetitions per level (default: 5)"
+            "\n        --help           display this help screen"
+            "\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    Options            opts;
+    vector<pn::string> replays;
+    vector<int32_t>    chapters;
+    callbacks.argument = [&replays](pn::string_view arg) {
+        replays.push_back(arg.copy());
+        return true;
+    };
+
+    callbacks.short_option = [&](pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'p': opts.plugin.emplace(get_value().copy()); return true;
+            case 'l':
+                chapters.emplace_back();
+                sfz::args::integer_option(get_value(), &chapters.back());
+                return true;
+            case 's': sfz::args::integer_option(get_value(), &opts.seed); return true;
+            case 'w': sfz::args::integer_option(get_value(), &opts.warmup); return true;
+            case 't': sfz::args::integer_option(get_value(), &opts.ticks); return true;
+            case 'r': sfz::args::integer_option(get_value(), &opts.repeat); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&](pn::string_view                     opt,
+                                const args::callbacks::get_value_f& get_value) {
+        if (opt == "plugin") {
+            return callbacks.short_option(pn::rune{'p'}, get_value);
+        } else if (opt == "level") {
+            return callbacks.short_option(pn::rune{'l'}, get_value);
+        } else if (opt == "seed") {
+            return callbacks.short_option(pn::rune{'s'}, get_value);
+        } else if (opt == "warmup") {
+            return callbacks.short_option(pn::rune{'w'}, get_value);
+        } else if (opt == "ticks") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "repeat") {
+            return callbacks.short_option(pn::rune{'r'}, get_value);
+        } else if (opt == "help") {
+            usage(pn::out, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if ((opts.ticks <= 0) || (opts.repeat <= 0) || (opts.warmup < 0)) {
+        throw std::runtime_error("--ticks and --repeat must be positive; --warmup nonnegative");
+    }
+
+    for (const pn::string& path : replays) {
+        sfz::mapped_file file(path);
+        ReplayData       replay(file.data());
+        opts.scenarios.push_back(Scenario{replay.chapter_id, replay.global_seed});
+    }
+    for (int32_t chapter : chapters) {
+        opts.scenarios.push_back(Scenario{chapter, opts.seed});
+    }
+
+    Preferences     preferences;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+    EventScheduler  scheduler;
+
+    TextVideoDriver video({640, 480}, sfz::optional<pn::string>());
+    video.loop(new BenchMaster(std::move(opts)), scheduler);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
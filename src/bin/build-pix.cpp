@@ -82,15 +82,11 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
 }
 
 std::function<pn::string_view()> prologue(pn::string_view chapter) {
-    return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.prologue;
-    };
+    return [chapter]() -> pn::string_view { return *Level::get(chapter)->solo.prologue; };
 }
 
 std::function<pn::string_view()> epilogue(pn::string_view chapter) {
-    return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.epilogue;
-    };
+    return [chapter]() -> pn::string_view { return *Level::get(chapter)->solo.epilogue; };
 }
 
 template <typename VideoDriver>
@@ -39,13 +39,17 @@
 #include "game/main.hpp"
 #include "game/messages.hpp"
 #include "game/motion.hpp"
+#include "game/profile.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/exception.hpp"
+#include "lang/memory.hpp"
+#include "lang/trace.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "sound/driver.hpp"
+#include "sound/mix-driver.hpp"
 #include "sound/music.hpp"
 #include "ui/card.hpp"
 #include "ui/interface-handling.hpp"
@@ -162,6 +166,11 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "\n    -t, --text           produce text output"
             "\n    -s, --smoke          run as smoke text"
             "\n        --opengl=2.0|3.2 select OpenGL version (default: 3.2)"
+            "\n        --trace=FILE     write a Chrome trace of the replay to FILE"
+            "\n        --profile        print time per tick spent in each subsystem"
+            "\n        --memory         print current and peak memory held by each subsystem"
+            "\n        --audio          mix sound into OUTPUT/sound.wav instead of logging it"
+            "\n        --mix-bench      mix sound in software and print the time it took"
             "\n        --help           display this help screen"
             "\n",
             progname);
@@ -189,6 +198,11 @@ void main(int argc, char* const* argv) {
     bool                      smoke        = false;
     std::pair<int, int>       gl_version   = {3, 2};
     pn::string_view           glsl_version = "330 core";
+    sfz::optional<pn::string> trace_path;
+    bool                      profile      = false;
+    bool                      print_memory = false;
+    bool                      audio        = false;
+    bool                      mix_bench    = false;
     callbacks.short_option = [&](pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'o': output_dir.emplace(get_value().copy()); return true;
@@ -226,6 +240,27 @@ void main(int argc, char* const* argv) {
                 throw std::runtime_error("invalid OpenGL version");
             }
             return true;
+        } else if (opt == "trace") {
+            if (!trace::enabled()) {
+                throw std::runtime_error("--trace: built with antares_trace = false");
+            }
+            trace_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "profile") {
+            if (!trace::enabled()) {
+                throw std::runtime_error("--profile: built with antares_trace = false");
+            }
+            profile = true;
+            return true;
+        } else if (opt == "memory") {
+            print_memory = true;
+            return true;
+        } else if (opt == "audio") {
+            audio = true;
+            return true;
+        } else if (opt == "mix-bench") {
+            mix_bench = true;
+            return true;
         } else if (opt == "help") {
             usage(pn::out, sfz::path::basename(argv[0]), 0);
             return true;
@@ -237,6 +272,8 @@ void main(int argc, char* const* argv) {
     args::parse(argc - 1, argv + 1, callbacks);
     if (!replay_path.has_value()) {
         throw std::runtime_error("missing required argument 'replay'");
+    } else if (audio && !output_dir.has_value()) {
+        throw std::runtime_error("--audio requires --output");
     }
 
     if (output_dir.has_value()) {
@@ -255,7 +292,16 @@ void main(int argc, char* const* argv) {
     }
 
     unique_ptr<SoundDriver> sound;
-    if (!smoke && output_dir.has_value()) {
+    MixSoundDriver*         mixer = nullptr;
+    if (audio || mix_bench) {
+        sfz::optional<pn::string> out;
+        if (audio) {
+            out.emplace(pn::format("{0}/sound.wav", *output_dir));
+        }
+        sound.reset(mixer = new MixSoundDriver(
+                            out.has_value() ? sfz::make_optional<pn::string_view>(*out)
+                                            : sfz::nullopt));
+    } else if (!smoke && output_dir.has_value()) {
         pn::string out = pn::format("{0}/sound.log", *output_dir);
         sound.reset(new LogSoundDriver(out));
     } else {
@@ -264,6 +310,9 @@ void main(int argc, char* const* argv) {
     NullLedger ledger;
 
     sfz::mapped_file replay_file(*replay_path);
+    if (trace_path.has_value() || profile) {
+        trace::start();
+    }
     if (smoke) {
         TextVideoDriver video({width, height}, sfz::optional<pn::string>());
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
@@ -274,6 +323,29 @@ void main(int argc, char* const* argv) {
         OffscreenVideoDriver video({width, height}, gl_version, glsl_version, output_dir);
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     }
+
+    if (mixer) {
+        mixer->advance(scheduler.now());
+        mixer->close();
+    }
+    trace::stop();
+    if (trace_path.has_value()) {
+        pn::output out = pn::output{*trace_path, pn::text}.check();
+        trace::write(out);
+    }
+    if (profile) {
+        TickProfile(trace::events()).print(pn::out);
+    }
+    if (print_memory) {
+        memory::print(pn::out);
+    }
+    if (mix_bench) {
+        const int64_t ns  = mixer->mix_time().count();
+        const int64_t sec = mixer->frames() / MixSoundDriver::kSampleRate;
+        pn::out.format(
+                "mixed {0} s of sound in {1} ms ({2} us per second of sound)\n", sec,
+                ns / 1000000, sec ? ((ns / 1000) / sec) : 0);
+    }
 }
 
 }  // namespace
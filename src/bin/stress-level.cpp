@@ -0,0 +1,267 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <math.h>
+#include <algorithm>
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/preferences.hpp"
+#include "data/base-object.hpp"
+#include "data/plugin.hpp"
+#include "data/resource.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "lang/exception.hpp"
+#include "math/random.hpp"
+#include "video/text-driver.hpp"
+
+using std::vector;
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+const double kTau = 6.283185307179586;
+
+// Ship classes that races may provide, as named by BuildableObject (e.g. "ish/cruiser" is the
+// Ishiman "cruiser").
+const char* const kClasses[] = {
+        "fighter", "gunship", "cruiser", "carrier", "aslttran", "defdrone", "transport", "engineer",
+};
+
+struct Options {
+    int                       admirals = 2;
+    int                       ships    = 50;
+    int                       weapons  = 100;  // percent of ships that are armed
+    int32_t                   size     = 20000;
+    int32_t                   seed     = 1;
+    int64_t                   chapter  = 1;
+    vector<pn::string>        races;
+    sfz::optional<pn::string> output_dir;
+};
+
+bool is_armed(const BaseObject& o) {
+    return o.weapons.pulse.has_value() || o.weapons.beam.has_value() ||
+           o.weapons.special.has_value();
+}
+
+struct Fleet {
+    pn::string_view    race;
+    vector<pn::string> armed;
+    vector<pn::string> unarmed;
+};
+
+Fleet fleet(pn::string_view race) {
+    load_race(NamedHandle<const Race>(race));
+    Fleet f{race};
+    for (const char* cls : kClasses) {
+        pn::string name = pn::format("{0}/{1}", race, cls);
+        if (!Resource::object_exists(name)) {
+            continue;
+        }
+        load_object(NamedHandle<const BaseObject>(name));
+        (is_armed(*BaseObject::get(name)) ? f.armed : f.unarmed).push_back(pn::string(cls));
+    }
+    if (f.armed.empty()) {
+        throw std::runtime_error(pn::format("race {0} has no armed ships", race).c_str());
+    }
+    return f;
+}
+
+// Coordinates may exceed the range of a single Random::next() call.
+int32_t spread(Random& random, int32_t radius) {
+    int32_t hi = random.next(256);
+    int32_t lo = random.next(256);
+    return ((((hi << 8) | lo) * int64_t{2 * radius}) >> 16) - radius;
+}
+
+pn::value stress_level(const Options& opts) {
+    Random random{opts.seed};
+
+    pn::array players;
+    pn::array initials;
+    for (int a = 0; a < opts.admirals; ++a) {
+        const Fleet f = fleet(opts.races[a % opts.races.size()]);
+        players.push_back(pn::map{
+                {"name", pn::format("Admiral {0}", a + 1)},
+                {"race", f.race.copy()},
+        });
+
+        // Fleets start evenly spaced on a circle, facing each other across the middle.
+        const double  angle  = (kTau * a) / opts.admirals;
+        const int32_t center = opts.size * 3 / 8;
+        const int32_t cx     = lround(center * cos(angle));
+        const int32_t cy     = lround(center * sin(angle));
+        const int32_t radius = std::max(opts.size / 8, 1);
+
+        for (int i = 0; i < opts.ships; ++i) {
+            const bool armed = f.unarmed.empty() || (random.next(100) < opts.weapons) || (i == 0);
+            const vector<pn::string>& classes = armed ? f.armed : f.unarmed;
+            pn::map                   initial{
+                    {"base", classes[random.next(classes.size())].copy()},
+                    {"owner", int64_t{a}},
+                    {"at",
+                     pn::map{
+                             {"x", int64_t{cx + spread(random, radius)}},
+                             {"y", int64_t{cy + spread(random, radius)}},
+                     }},
+            };
+            if (i == 0) {
+                initial.set("flagship", true);
+            }
+            initials.push_back(std::move(initial));
+        }
+    }
+
+    return pn::map{
+            {"type", "demo"},
+            {"chapter", opts.chapter},
+            {"title", pn::format("Stress: {0} × {1}", opts.admirals, opts.ships)},
+            {"angle", int64_t{0}},
+            {"players", std::move(players)},
+            {"initials", std::move(initials)},
+            {"conditions", pn::array{}},
+            {"briefings", pn::array{}},
+    };
+}
+
+void write(pn::string_view path, pn::value_cref x) {
+    try {
+        sfz::makedirs(sfz::path::dirname(path), 0755);
+        pn::output out = pn::output{path, pn::text}.check();
+        out.dump(x);
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error(path.copy().c_str()));
+    }
+}
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS]\n"
+            "\n"
+            "  Generates a plugin with a single synthetic level, in which every admiral is\n"
+            "  computer-controlled, for loading the simulation with many ships.  Run it with:\n"
+            "    bench --plugin=OUTPUT\n"
+            "\n"
+            "  options:\n"
+            "    -o, --output=OUTPUT    place plugin in this directory (required)\n"
+            "    -a, --admirals=COUNT   number of admirals, at most {1} (default: 2)\n"
+            "    -n, --ships=COUNT      ships per admiral (default: 50)\n"
+            "    -w, --weapons=PERCENT  percentage of armed ships (default: 100)\n"
+            "    -m, --size=SIZE        width of the battlefield (default: 20000)\n"
+            "    -r, --race=RACE        race of the next admiral; repeat to alternate races\n"
+            "                           (default: ish, then gai)\n"
+            "    -s, --seed=SEED        random seed (default: 1)\n"
+            "    -c, --chapter=CHAPTER  chapter number of the level (default: 1)\n"
+            "    -h, --help             display this help screen\n",
+            progname, static_cast<int64_t>(kMaxPlayerNum));
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    callbacks.argument = [](pn::string_view arg) { return false; };
+
+    Options opts;
+    callbacks.short_option = [&argv, &opts](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'o': opts.output_dir.emplace(get_value().copy()); return true;
+            case 'a': sfz::args::integer_option(get_value(), &opts.admirals); return true;
+            case 'n': sfz::args::integer_option(get_value(), &opts.ships); return true;
+            case 'w': sfz::args::integer_option(get_value(), &opts.weapons); return true;
+            case 'm': sfz::args::integer_option(get_value(), &opts.size); return true;
+            case 's': sfz::args::integer_option(get_value(), &opts.seed); return true;
+            case 'c': sfz::args::integer_option(get_value(), &opts.chapter); return true;
+            case 'r': opts.races.push_back(get_value().copy()); return true;
+            case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
+            default: return false;
+        }
+    };
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "output") {
+                    return callbacks.short_option(pn::rune{'o'}, get_value);
+                } else if (opt == "admirals") {
+                    return callbacks.short_option(pn::rune{'a'}, get_value);
+                } else if (opt == "ships") {
+                    return callbacks.short_option(pn::rune{'n'}, get_value);
+                } else if (opt == "weapons") {
+                    return callbacks.short_option(pn::rune{'w'}, get_value);
+                } else if (opt == "size") {
+                    return callbacks.short_option(pn::rune{'m'}, get_value);
+                } else if (opt == "race") {
+                    return callbacks.short_option(pn::rune{'r'}, get_value);
+                } else if (opt == "seed") {
+                    return callbacks.short_option(pn::rune{'s'}, get_value);
+                } else if (opt == "chapter") {
+                    return callbacks.short_option(pn::rune{'c'}, get_value);
+                } else if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!opts.output_dir.has_value()) {
+        throw std::runtime_error("missing required option --output");
+    } else if ((opts.admirals < 1) || (opts.admirals > kMaxPlayerNum)) {
+        throw std::runtime_error(
+                pn::format(
+                        "--admirals must be between 1 and {0}",
+                        static_cast<int64_t>(kMaxPlayerNum)).c_str());
+    } else if ((opts.ships < 1) || ((opts.admirals * opts.ships) > kMaxSpaceObject)) {
+        throw std::runtime_error(
+                pn::format("total ships must be between 1 and {0}", kMaxSpaceObject).c_str());
+    } else if ((opts.weapons < 0) || (opts.weapons > 100)) {
+        throw std::runtime_error("--weapons must be between 0 and 100");
+    } else if ((opts.size < 8) || (opts.size > 0x40000000)) {
+        throw std::runtime_error("--size out of range");
+    }
+    if (opts.races.empty()) {
+        opts.races.push_back("ish");
+        opts.races.push_back("gai");
+    }
+
+    NullPrefsDriver prefs;
+    TextVideoDriver video({640, 480}, {});
+    init_globals();
+    PluginInit(sfz::nullopt);
+
+    const pn::value level = stress_level(opts);
+    write(pn::format("{0}/levels/stress.pn", *opts.output_dir), level);
+    write(pn::format("{0}/info.pn", *opts.output_dir),
+          pn::map{
+                  {"title", "Stress Test"},
+                  {"format", plug.info.format},
+                  {"author", "stress-level"},
+                  {"version", "1.0"},
+          });
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
@@ -49,6 +49,8 @@ Directories linux_dirs() {
     }
     directories.root += "/.local/share/games/antares";
 
+    directories.cache = directories.root.copy();
+    directories.cache += "/cache";
     directories.downloads = directories.root.copy();
     directories.downloads += "/downloads";
     directories.registry = directories.root.copy();
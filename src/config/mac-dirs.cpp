@@ -58,6 +58,7 @@ Directories mac_dirs() {
     }
     directories.root += "/Library/Application Support/Antares";
 
+    directories.cache     = pn::format("{0}/Caches", directories.root);
     directories.downloads = pn::format("{0}/Downloads", directories.root);
     directories.registry  = pn::format("{0}/Registry", directories.root);
     directories.replays   = pn::format("{0}/Replays", directories.root);
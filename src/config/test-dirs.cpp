@@ -36,6 +36,7 @@ pn::string_view default_factory_scenario_path() {
 Directories test_dirs() {
     Directories directories;
     directories.root      = application_path().copy();
+    directories.cache     = pn::string_view{ANTARES_TEST_CACHE}.copy();
     directories.downloads = pn::format("{0}/downloads", directories.root);
     directories.registry  = pn::format("{0}/registry", directories.root);
     directories.replays   = pn::format("{0}/replays", directories.root);
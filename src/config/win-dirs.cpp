@@ -80,6 +80,7 @@ Directories win_dirs() {
 
     directories.root += "/Antares";
 
+    directories.cache     = pn::format("{0}/Caches", directories.root);
     directories.downloads = pn::format("{0}/Downloads", directories.root);
     directories.registry  = pn::format("{0}/Registry", directories.root);
     directories.replays   = pn::format("{0}/Replays", directories.root);
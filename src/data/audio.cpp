@@ -25,14 +25,33 @@
 #include <memory>
 #include <pn/output>
 #include <stdexcept>
+#include <vector>
 
 namespace antares {
 
+SoundData read_all(AudioStream* stream) {
+    SoundData s;
+    s.channels  = stream->channels();
+    s.frequency = stream->frequency();
+    // Decode straight into a buffer that doubles as it fills, then copy once.
+    std::vector<uint8_t> buffer(65536);
+    size_t               size = 0;
+    while (size_t n = stream->read(buffer.data() + size, buffer.size() - size)) {
+        size += n;
+        if (size == buffer.size()) {
+            buffer.resize(2 * buffer.size());
+        }
+    }
+    s.data = pn::data_view{buffer.data(), static_cast<int>(size)}.copy();
+    return s;
+}
+
 namespace sndfile {
 
 namespace {
 
 struct VirtualFile {
+    pn::data      owned;
     pn::data_view data;
     size_t        pointer;
 
@@ -105,7 +124,32 @@ static sf_count_t sf_vio_tell(void* user_data) {
     return reinterpret_cast<VirtualFile*>(user_data)->tell();
 }
 
-SoundData convert(pn::data_view in) {
+namespace {
+
+class SndfileStream : public AudioStream {
+  public:
+    SndfileStream(std::unique_ptr<VirtualFile> userdata, SNDFILE* file, const SF_INFO& info)
+            : AudioStream(info.channels, info.samplerate),
+              _userdata(std::move(userdata)),
+              _file(file, sf_close) {}
+
+    size_t read(void* out, size_t size) override {
+        sf_count_t frames = size / (sizeof(int16_t) * channels());
+        sf_count_t count =
+                sf_read_short(_file.get(), static_cast<short*>(out), frames * channels());
+        return count * sizeof(int16_t);
+    }
+
+    void rewind() override { sf_seek(_file.get(), 0, SEEK_SET); }
+
+  private:
+    std::unique_ptr<VirtualFile>                  _userdata;
+    std::unique_ptr<SNDFILE, decltype(&sf_close)> _file;
+};
+
+}  // namespace
+
+std::unique_ptr<AudioStream> stream(pn::data in) {
     SF_VIRTUAL_IO io = {};
     io.get_filelen   = sf_vio_get_filelen;
     io.seek          = sf_vio_seek;
@@ -113,14 +157,15 @@ SoundData convert(pn::data_view in) {
     io.write         = sf_vio_write;
     io.tell          = sf_vio_tell;
 
-    VirtualFile userdata = {};
-    userdata.data        = in;
-    userdata.pointer     = 0;
+    // libsndfile keeps `userdata`, so it must not move.
+    std::unique_ptr<VirtualFile> userdata(new VirtualFile{std::move(in)});
+    userdata->data    = userdata->owned;
+    userdata->pointer = 0;
 
     SF_INFO info = {};
 
     std::unique_ptr<SNDFILE, decltype(&sf_close)> file(
-            sf_open_virtual(&io, SFM_READ, &info, &userdata), sf_close);
+            sf_open_virtual(&io, SFM_READ, &info, userdata.get()), sf_close);
 
     if (!file.get()) {
         throw std::runtime_error(sf_strerror(NULL));
@@ -130,22 +175,34 @@ SoundData convert(pn::data_view in) {
         throw std::runtime_error(pn::format("audio file has {0} channels", info.channels).c_str());
     }
 
-    SoundData s;
-    s.frequency = info.samplerate;
-    s.channels  = info.channels;
-    int16_t shorts[1024];
-    while (auto count = sf_read_short(file.get(), shorts, 1024)) {
-        s.data += pn::data_view{reinterpret_cast<uint8_t*>(shorts),
-                                static_cast<int>(sizeof(int16_t) * count)};
-    }
-    return s;
+    return std::unique_ptr<AudioStream>(
+            new SndfileStream(std::move(userdata), file.release(), info));
 }
 
+SoundData convert(pn::data_view in) { return read_all(stream(in.copy()).get()); }
+
 }  // namespace sndfile
 
 namespace modplug {
 
-SoundData convert(pn::data_view in) {
+namespace {
+
+class ModPlugStream : public AudioStream {
+  public:
+    ModPlugStream(pn::data in, ::ModPlugFile* file)
+            : AudioStream(2, 44100), _in(std::move(in)), _file(file, ModPlug_Unload) {}
+
+    size_t read(void* out, size_t size) override { return ModPlug_Read(_file.get(), out, size); }
+    void   rewind() override { ModPlug_Seek(_file.get(), 0); }
+
+  private:
+    pn::data                                                  _in;
+    std::unique_ptr<::ModPlugFile, decltype(&ModPlug_Unload)> _file;
+};
+
+}  // namespace
+
+std::unique_ptr<AudioStream> stream(pn::data in) {
     ModPlug_Settings settings;
     ModPlug_GetSettings(&settings);
     settings.mFlags            = MODPLUG_ENABLE_OVERSAMPLING;
@@ -155,21 +212,16 @@ SoundData convert(pn::data_view in) {
     settings.mStereoSeparation = 128;
     settings.mResamplingMode   = MODPLUG_RESAMPLE_NEAREST;  // "Low" quality, but matches original game's behavior and makes most instruments sound sharper
     ModPlug_SetSettings(&settings);
-    std::unique_ptr<::ModPlugFile, decltype(&ModPlug_Unload)> file(
-            ModPlug_Load(in.data(), in.size()), ModPlug_Unload);
 
-    SoundData s;
-    s.channels  = 2;
-    s.frequency = 44100;
-    uint8_t buffer[1024];
-    pn::data_view::size_type read;
-    do {
-        read = ModPlug_Read(file.get(), buffer, 1024);
-        s.data += pn::data_view(buffer, read);
-    } while (read > 0);
-    return s;
+    ::ModPlugFile* file = ModPlug_Load(in.data(), in.size());
+    if (!file) {
+        throw std::runtime_error("couldn't load module");
+    }
+    return std::unique_ptr<AudioStream>(new ModPlugStream(std::move(in), file));
 }
 
+SoundData convert(pn::data_view in) { return read_all(stream(in.copy()).get()); }
+
 }  // namespace modplug
 
 }  // namespace antares
@@ -0,0 +1,77 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/cache-file.hpp"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <stdexcept>
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <process.h>
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include "lang/defines.hpp"
+
+namespace path = sfz::path;
+
+namespace antares {
+
+static ANTARES_GLOBAL std::atomic<int> temp_count{0};
+
+static int process_id() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
+
+// Renames `from` to `to`, replacing `to` if it exists.  rename() does that on POSIX, but fails on
+// Windows if `to` exists, so that a second writer of the same file would fail.
+static bool replace_file(pn::string_view from, pn::string_view to) {
+#ifdef _WIN32
+    return MoveFileExA(from.copy().c_str(), to.copy().c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.copy().c_str(), to.copy().c_str()) == 0;
+#endif
+}
+
+void write_cache_file(pn::string_view path, pn::data_view data) {
+    sfz::makedirs(path::dirname(path), 0755);
+    pn::string tmp = pn::format("{0}.{1}-{2}.tmp", path, process_id(), ++temp_count);
+    try {
+        pn::output{tmp, pn::binary}.write(data).check();
+    } catch (...) {
+        remove(tmp.c_str());
+        throw;
+    }
+    if (!replace_file(tmp, path)) {
+        remove(tmp.c_str());
+        throw std::runtime_error(pn::format("couldn't rename {0}", tmp).c_str());
+    }
+}
+
+}  // namespace antares
@@ -67,11 +67,12 @@ const Level* Level::get(int number) { return Level::get(plug.chapters[number]);
 
 const Level* Level::get(pn::string_view name) {
     auto it = plug.levels.find(name.copy());
-    if (it == plug.levels.end()) {
-        return nullptr;
-    } else {
+    if (it != plug.levels.end()) {
         return &it->second;
+    } else if (plug.level_index.find(name.copy()) == plug.level_index.end()) {
+        return nullptr;
     }
+    return &plug.levels.emplace(name.copy(), Resource::level(name)).first->second;
 }
 
 FIELD_READER(LevelBase::PlayerType) {
@@ -184,4 +185,12 @@ Level level(pn::value_cref x0) {
     }
 }
 
+LevelInfo level_info(pn::value_cref x0) {
+    path_value x{x0};
+    LevelInfo  info;
+    info.chapter = read_field<sfz::optional<int64_t>>(x.get("chapter"));
+    info.title   = read_field<pn::string>(x.get("title"));
+    return info;
+}
+
 }  // namespace antares
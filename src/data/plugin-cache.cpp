@@ -0,0 +1,343 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2016-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/plugin-cache.hpp"
+
+#include <string.h>
+
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/dirs.hpp"
+#include "data/cache-file.hpp"
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+// Bump kVersion whenever the encoding below changes.
+//
+// Layout:
+//   char      magic[8]
+//   uint32_t  version           (native byte order)
+//   uint32_t  compiler version  (native byte order)
+//   uint32_t  entry count       (native byte order)
+//   string    digest
+//   entry     entries[count]
+//
+// where a string is a varint length followed by that many bytes, an entry is a string (the
+// resource path) followed by a string (the encoded value), and an encoded value is a tag byte
+// followed by its payload.
+const char     kMagic[8] = {'A', 'N', 'T', 'P', 'L', 'U', 'G', '\n'};
+const uint32_t kVersion  = 2;
+
+enum : uint8_t {
+    NULL_TAG   = 0,
+    FALSE_TAG  = 1,
+    TRUE_TAG   = 2,
+    INT_TAG    = 3,  // zigzag varint
+    FLOAT_TAG  = 4,  // 8 bytes, native byte order
+    DATA_TAG   = 5,  // string
+    STRING_TAG = 6,  // string
+    ARRAY_TAG  = 7,  // varint count, then values
+    MAP_TAG    = 8,  // varint count, then (string key, value) pairs
+};
+
+void write_bytes(pn::data& out, const void* bytes, size_t size) {
+    out += pn::data_view{reinterpret_cast<const uint8_t*>(bytes), static_cast<int>(size)};
+}
+
+void write_varint(pn::data& out, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        write_bytes(out, &byte, 1);
+    } while (value);
+}
+
+void write_string(pn::data& out, pn::data_view s) {
+    write_varint(out, s.size());
+    out += s;
+}
+
+void write_string(pn::data& out, pn::string_view s) {
+    write_varint(out, s.size());
+    write_bytes(out, s.data(), s.size());
+}
+
+void write_value(pn::data& out, pn::value_cref x) {
+    uint8_t tag;
+    switch (x.type()) {
+        case PN_NULL:
+            tag = NULL_TAG;
+            write_bytes(out, &tag, 1);
+            return;
+
+        case PN_BOOL:
+            tag = x.as_bool() ? TRUE_TAG : FALSE_TAG;
+            write_bytes(out, &tag, 1);
+            return;
+
+        case PN_INT: {
+            tag       = INT_TAG;
+            int64_t i = x.as_int();
+            write_bytes(out, &tag, 1);
+            write_varint(out, (static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63));
+            return;
+        }
+
+        case PN_FLOAT: {
+            tag      = FLOAT_TAG;
+            double f = x.as_float();
+            write_bytes(out, &tag, 1);
+            write_bytes(out, &f, sizeof(f));
+            return;
+        }
+
+        case PN_DATA:
+            tag = DATA_TAG;
+            write_bytes(out, &tag, 1);
+            write_string(out, x.as_data());
+            return;
+
+        case PN_STRING:
+            tag = STRING_TAG;
+            write_bytes(out, &tag, 1);
+            write_string(out, x.as_string());
+            return;
+
+        case PN_ARRAY:
+            tag = ARRAY_TAG;
+            write_bytes(out, &tag, 1);
+            write_varint(out, x.as_array().size());
+            for (pn::value_cref item : x.as_array()) {
+                write_value(out, item);
+            }
+            return;
+
+        case PN_MAP:
+            tag = MAP_TAG;
+            write_bytes(out, &tag, 1);
+            write_varint(out, x.as_map().size());
+            for (pn::key_value_cref kv : x.as_map()) {
+                write_string(out, kv.key());
+                write_value(out, kv.value());
+            }
+            return;
+    }
+}
+
+// Bounds-checked cursor over encoded data.  Any overrun throws, which callers treat as a corrupt
+// cache.
+class Reader {
+  public:
+    explicit Reader(pn::data_view data) : _p(data.data()), _end(data.data() + data.size()) {}
+
+    bool done() const { return _p == _end; }
+
+    const uint8_t* bytes(size_t size) {
+        if (size > static_cast<size_t>(_end - _p)) {
+            throw std::runtime_error("truncated plugin cache");
+        }
+        const uint8_t* p = _p;
+        _p += size;
+        return p;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = *bytes(1);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("invalid varint in plugin cache");
+    }
+
+    pn::data_view data() {
+        size_t size = varint();
+        return pn::data_view{bytes(size), static_cast<int>(size)};
+    }
+
+    pn::string_view string() {
+        size_t size = varint();
+        return pn::string_view{reinterpret_cast<const char*>(bytes(size)),
+                               static_cast<int>(size)};
+    }
+
+    pn::value value() {
+        switch (*bytes(1)) {
+            case NULL_TAG: return pn::value{};
+            case FALSE_TAG: return pn::value{false};
+            case TRUE_TAG: return pn::value{true};
+
+            case INT_TAG: {
+                uint64_t u = varint();
+                return pn::value{static_cast<int64_t>((u >> 1) ^ -(u & 1))};
+            }
+
+            case FLOAT_TAG: {
+                double f;
+                memcpy(&f, bytes(sizeof(f)), sizeof(f));
+                return pn::value{f};
+            }
+
+            case DATA_TAG: return pn::value{data().copy()};
+            case STRING_TAG: return pn::value{string().copy()};
+
+            case ARRAY_TAG: {
+                pn::array a;
+                for (uint64_t n = varint(); n > 0; --n) {
+                    a.push_back(value());
+                }
+                return pn::value{std::move(a)};
+            }
+
+            case MAP_TAG: {
+                pn::map m;
+                for (uint64_t n = varint(); n > 0; --n) {
+                    pn::string_view k = string();
+                    m.set(k, value());
+                }
+                return pn::value{std::move(m)};
+            }
+        }
+        throw std::runtime_error("invalid tag in plugin cache");
+    }
+
+  private:
+    const uint8_t*       _p;
+    const uint8_t* const _end;
+};
+
+pn::string cache_path(pn::string_view digest) {
+    return pn::format("{0}/{1}/plugin.bin", dirs().cache, digest);
+}
+
+}  // namespace
+
+PluginCache::PluginCache() : _charge(memory::PLUGIN) {}
+PluginCache::~PluginCache() {}
+
+std::unique_ptr<PluginCache> PluginCache::open(
+        pn::string_view digest, uint32_t compiler_version) {
+    pn::string path = cache_path(digest);
+    if (!path::isfile(path)) {
+        return nullptr;
+    }
+    try {
+        std::unique_ptr<PluginCache> cache(new PluginCache);
+        cache->_file.reset(new sfz::mapped_file(path));
+        cache->_charge = memory::Charge{memory::MAPPED};
+        if (cache->index(digest, compiler_version, cache->_file->data())) {
+            return cache;
+        }
+    } catch (...) {
+        // Unreadable or corrupt; it will be rebuilt.
+    }
+    return nullptr;
+}
+
+pn::data PluginCache::encode(pn::value_cref x) {
+    pn::data out;
+    write_value(out, x);
+    return out;
+}
+
+bool PluginCache::decode(pn::data_view data, pn::value* out) {
+    try {
+        Reader in{data};
+        *out = in.value();
+        return in.done();
+    } catch (std::runtime_error& e) {
+        return false;
+    }
+}
+
+bool PluginCache::index(pn::string_view digest, uint32_t compiler_version, pn::data_view data) {
+    _charge.reset(data.size());
+    Reader in{data};
+    if (memcmp(in.bytes(sizeof(kMagic)), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    uint32_t version, compiler, count;
+    memcpy(&version, in.bytes(sizeof(version)), sizeof(version));
+    memcpy(&compiler, in.bytes(sizeof(compiler)), sizeof(compiler));
+    memcpy(&count, in.bytes(sizeof(count)), sizeof(count));
+    if ((version != kVersion) || (compiler != compiler_version) || (in.string() != digest)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        pn::string_view path = in.string();
+        _entries[path.copy()] = in.data();
+    }
+    return in.done();
+}
+
+bool PluginCache::get(pn::string_view path, pn::value* out) const {
+    auto it = _entries.find(path.copy());
+    if (it == _entries.end()) {
+        return false;
+    }
+    return decode(it->second, out);
+}
+
+PluginCache::Builder::Builder() : _count(0) {}
+
+void PluginCache::Builder::add(pn::string_view path, pn::value_cref x) {
+    write_string(_entries, path);
+    write_string(_entries, encode(x));
+    ++_count;
+}
+
+std::unique_ptr<PluginCache> PluginCache::Builder::finish(
+        pn::string_view digest, uint32_t compiler_version) {
+    pn::data out;
+    write_bytes(out, kMagic, sizeof(kMagic));
+    write_bytes(out, &kVersion, sizeof(kVersion));
+    write_bytes(out, &compiler_version, sizeof(compiler_version));
+    write_bytes(out, &_count, sizeof(_count));
+    write_string(out, digest);
+    out += _entries;
+
+    try {
+        write_cache_file(cache_path(digest), out);
+    } catch (...) {
+        // The cache is only an optimization; serve this session from memory.
+    }
+
+    std::unique_ptr<PluginCache> cache(new PluginCache);
+    cache->_owned = std::move(out);
+    if (!cache->index(digest, compiler_version, cache->_owned)) {
+        throw std::runtime_error("failed to index plugin cache");
+    }
+    _count   = 0;
+    _entries = pn::data{};
+    return cache;
+}
+
+}  // namespace antares
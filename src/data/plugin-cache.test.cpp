@@ -0,0 +1,116 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2016-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/plugin-cache.hpp"
+
+#include <gmock/gmock.h>
+#include <limits>
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <vector>
+
+using testing::ElementsAre;
+
+namespace antares {
+namespace {
+
+using PluginCacheTest = testing::Test;
+
+std::vector<uint8_t> bytes(pn::data_view d) {
+    return std::vector<uint8_t>(d.data(), d.data() + d.size());
+}
+
+// Encodes `x`, decodes the result, and returns the decoded value, dumped for comparison.
+pn::string round_trip(pn::value_cref x) {
+    pn::value out;
+    EXPECT_TRUE(PluginCache::decode(PluginCache::encode(x), &out));
+    return pn::dump(out, pn::dump_short);
+}
+
+TEST_F(PluginCacheTest, Tags) {
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{})), ElementsAre(0));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{false})), ElementsAre(1));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{true})), ElementsAre(2));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{"ab"})), ElementsAre(6, 2, 'a', 'b'));
+    EXPECT_THAT(
+            bytes(PluginCache::encode(pn::array{pn::value{}, pn::value{true}})),
+            ElementsAre(7, 2, 0, 2));
+    EXPECT_THAT(
+            bytes(PluginCache::encode(pn::map{{"k", false}})), ElementsAre(8, 1, 1, 'k', 1));
+}
+
+TEST_F(PluginCacheTest, Varint) {
+    // Integers are zigzag-encoded, so small negative numbers stay short.
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{0}})), ElementsAre(3, 0));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{-1}})), ElementsAre(3, 1));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{1}})), ElementsAre(3, 2));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{63}})), ElementsAre(3, 126));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{-64}})), ElementsAre(3, 127));
+    EXPECT_THAT(bytes(PluginCache::encode(pn::value{int64_t{64}})), ElementsAre(3, 0x80, 0x01));
+    EXPECT_THAT(
+            bytes(PluginCache::encode(pn::value{int64_t{8192}})),
+            ElementsAre(3, 0x80, 0x80, 0x01));
+
+    const int64_t kMin = std::numeric_limits<int64_t>::min();
+    const int64_t kMax = std::numeric_limits<int64_t>::max();
+    EXPECT_EQ(
+            std::vector<uint8_t>({3, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}),
+            bytes(PluginCache::encode(pn::value{kMax})));
+    EXPECT_EQ(
+            std::vector<uint8_t>({3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}),
+            bytes(PluginCache::encode(pn::value{kMin})));
+}
+
+TEST_F(PluginCacheTest, RoundTrip) {
+    for (int64_t i : std::vector<int64_t>{0, 1, -1, 63, 64, -64, -65, 1 << 20, -(1 << 20),
+                                          std::numeric_limits<int64_t>::min(),
+                                          std::numeric_limits<int64_t>::max()}) {
+        EXPECT_EQ(pn::dump(pn::value{i}, pn::dump_short), round_trip(pn::value{i}));
+    }
+    for (double f : {0.0, -0.5, 1.25, 1e300}) {
+        EXPECT_EQ(pn::dump(pn::value{f}, pn::dump_short), round_trip(pn::value{f}));
+    }
+
+    const uint8_t data[] = {0, 1, 0x80, 0xff};
+    pn::value     x{pn::map{
+            {"null", pn::value{}},
+            {"bool", true},
+            {"string", "a b"},
+            {"data", pn::value{pn::data_view{data, sizeof(data)}.copy()}},
+            {"array", pn::array{int64_t{1}, "two", pn::array{}, pn::map{}}},
+            {"map", pn::map{{"nested", pn::map{{"x", int64_t{-3}}}}}},
+    }};
+    EXPECT_EQ(pn::dump(x, pn::dump_short), round_trip(x));
+}
+
+TEST_F(PluginCacheTest, Invalid) {
+    pn::value     out;
+    const uint8_t bad_tag[]   = {9};
+    const uint8_t truncated[] = {6, 3, 'a', 'b'};
+    const uint8_t long_int[]  = {3, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+    const uint8_t trailing[]  = {0, 0};
+    EXPECT_FALSE(PluginCache::decode(pn::data_view{}, &out));
+    EXPECT_FALSE(PluginCache::decode(pn::data_view{bad_tag, sizeof(bad_tag)}, &out));
+    EXPECT_FALSE(PluginCache::decode(pn::data_view{truncated, sizeof(truncated)}, &out));
+    EXPECT_FALSE(PluginCache::decode(pn::data_view{long_int, sizeof(long_int)}, &out));
+    EXPECT_FALSE(PluginCache::decode(pn::data_view{trailing, sizeof(trailing)}, &out));
+}
+
+}  // namespace
+}  // namespace antares
@@ -18,6 +18,8 @@
 
 #include "data/plugin.hpp"
 
+#include <sys/stat.h>
+
 #include <algorithm>
 #include <pn/output>
 #include <sfz/sfz.hpp>
@@ -30,8 +32,10 @@
 #include "data/field.hpp"
 #include "data/initial.hpp"
 #include "data/level.hpp"
+#include "data/plugin-cache.hpp"
 #include "data/races.hpp"
 #include "data/resource.hpp"
+#include "data/sound-bank.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 
@@ -47,15 +51,94 @@ static constexpr int kPluginFormat = 21;
 static constexpr const char kSplashPicture[]  = "splash";
 static constexpr const char kStarmapPicture[] = "starmap";
 
+// Subdirectories of a data source that contribute to its digest.  Anything else that lives
+// alongside them (downloads, caches, saved replays) may change without invalidating caches.
+// Music is left out: no cache is derived from it, and it is the largest data to hash.
+static constexpr const char* kDigestDirs[] = {
+        "fonts", "interfaces", "levels",  "objects", "pictures",
+        "races", "sounds",     "sprites", "strings", "text",
+};
+
 ANTARES_GLOBAL ScenarioGlobals plug;
 
-static void read_all_levels() {
+static pn::string stamp(pn::string_view path, int64_t size, int64_t mtime) {
+    return pn::format("{0}\t{1}\t{2}\n", path, size, mtime);
+}
+
+namespace {
+
+// Collects a stamp of each regular file under a directory.
+class StampWalker : public sfz::TreeWalker {
+  public:
+    StampWalker(std::vector<pn::string>* stamps) : _stamps(stamps) {}
+
+    void file(pn::string_view name, const sfz::Stat& st) const override {
+        _stamps->push_back(stamp(name, st.st_size, st.st_mtime));
+    }
+
+    // Ignore non-regular-files:
+    void pre_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void cycle_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void post_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void symlink(pn::string_view name, const sfz::Stat& st) const override {}
+    void broken_symlink(pn::string_view name, const sfz::Stat& st) const override {}
+    void other(pn::string_view name, const sfz::Stat& st) const override {}
+
+  private:
+    std::vector<pn::string>* const _stamps;
+};
+
+}  // namespace
+
+static void digest_file(sfz::sha1* sha, pn::string_view path) {
+    struct stat st;
+    if (stat(path.copy().c_str(), &st) == 0) {
+        sha->write(stamp(path, st.st_size, st.st_mtime));
+    }
+}
+
+// Files are identified by path, size and modification time, not by content, so that checking the
+// caches costs a walk of the data directories rather than a read of every file in them.
+static void digest_dir(sfz::sha1* sha, pn::string_view root) {
+    digest_file(sha, pn::format("{0}/info.pn", root));
+    for (const char* dir : kDigestDirs) {
+        pn::string path = pn::format("{0}/{1}", root, dir);
+        if (path::isdir(path)) {
+            std::vector<pn::string> stamps;
+            sfz::walk(path, sfz::WALK_PHYSICAL, StampWalker(&stamps));
+            std::sort(stamps.begin(), stamps.end());
+            for (const pn::string& s : stamps) {
+                sha->write(s);
+            }
+        }
+    }
+}
+
+// Digest of every source that ResourceData might load from, in override order.
+static pn::string data_digest() {
+    sfz::sha1 sha;
+    sha.write(pn::format("format:{0}\n", kPluginFormat));
+    if (plug.dir.has_value()) {
+        digest_dir(&sha, *plug.dir);
+    } else if (plug.zip) {
+        digest_file(&sha, plug.zip->path());
+    }
+    digest_dir(&sha, factory_scenario_path());
+    digest_dir(&sha, application_path());
+    return sha.compute().hex();
+}
+
+// Indexes levels by name and chapter.  Each level's procyon is still parsed here (or read from the
+// plugin cache), but only its chapter and title are read from it; Level::get() builds the rest of
+// the level when it is first needed.
+static void read_level_index() {
+    plug.level_index.clear();
     plug.levels.clear();
     plug.chapters.clear();
     for (pn::string_view name : Resource::list_levels()) {
-        auto it = plug.levels.emplace(name.copy(), Resource::level(name)).first;
-        if (it->second.base.chapter.has_value()) {
-            auto chapter = *it->second.base.chapter;
+        auto it = plug.level_index.emplace(name.copy(), Resource::level_info(name)).first;
+        if (it->second.chapter.has_value()) {
+            auto chapter = *it->second.chapter;
             if (plug.chapters.find(chapter) != plug.chapters.end()) {
                 throw std::runtime_error(pn::format(
                                                  "duplicate chapter {} in levels {} and {}",
@@ -78,19 +161,28 @@ void PluginInit(sfz::optional<pn::string_view> path) {
         }
     }
 
+    // Check info.pn before mounting, which may compile the whole plugin and write its cache.
     plug.info = Resource::info();
     try {
         if (plug.info.format != kPluginFormat) {
             throw std::runtime_error(
                     pn::format("unknown plugin format {0}", plug.info.format).c_str());
         }
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error("info.pn"));
+    }
+
+    plug.digest = data_digest();
+    Resource::mount();
+
+    try {
         plug.splash  = Resource::texture(kSplashPicture);
         plug.starmap = Resource::texture(kStarmapPicture);
     } catch (...) {
         std::throw_with_nested(std::runtime_error("info.pn"));
     }
 
-    read_all_levels();
+    read_level_index();
 }
 
 void load_race(const NamedHandle<const Race>& r) {
@@ -98,6 +190,7 @@ void load_race(const NamedHandle<const Race>& r) {
         return;  // already loaded.
     }
     plug.races.emplace(r.name().copy(), Resource::race(r.name()));
+    plug.loaded_charge.reset(plug.loaded_charge.bytes() + sizeof(Race));
 }
 
 void load_object(const NamedHandle<const BaseObject>& o) {
@@ -105,6 +198,7 @@ void load_object(const NamedHandle<const BaseObject>& o) {
         return;  // already loaded.
     }
     plug.objects.emplace(o.name().copy(), Resource::object(o.name()));
+    plug.loaded_charge.reset(plug.loaded_charge.bytes() + sizeof(BaseObject));
 }
 
 }  // namespace antares
@@ -20,7 +20,11 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <array>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include <pn/input>
 #include <sfz/sfz.hpp>
 #include <zipxx/zipxx.hpp>
@@ -37,12 +41,17 @@
 #include "data/initial.hpp"
 #include "data/interface.hpp"
 #include "data/level.hpp"
+#include "data/plugin-cache.hpp"
 #include "data/plugin.hpp"
 #include "data/races.hpp"
 #include "data/replay.hpp"
+#include "data/sound-bank.hpp"
 #include "data/sprite-data.hpp"
 #include "drawing/text.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
+#include "lang/memory.hpp"
+#include "lang/trace.hpp"
 #include "video/driver.hpp"
 
 namespace path = sfz::path;
@@ -51,47 +60,202 @@ namespace antares {
 
 namespace {
 
-class ResourceLister : public sfz::TreeWalker {
-  public:
-    ResourceLister(pn::string_view root, pn::string_view extension, std::vector<pn::string>* names)
-            : _root_size(root.size()), _extension(extension), _names(names) {}
+// Top-level entries of a data source that hold resources.  Anything else there (downloads,
+// caches, other scenarios) is left out of the index.
+const char* const kResourceDirs[] = {
+        "fonts", "interfaces", "levels", "music",   "objects", "pictures",
+        "races", "replays",    "sounds", "sprites", "strings", "text",
+};
+const char* const kResourceFiles[] = {"info.pn", "rotation-table"};
+
+// Canonical form of a resource path: '/'-separated, with no empty or "." components.
+pn::string normalize(pn::string_view path) {
+    std::string result;
+    std::string component;
+    for (size_t i = 0; i <= path.size(); ++i) {
+        char c = (i < path.size()) ? path.data()[i] : '/';
+        if ((c != '/') && (c != '\\')) {
+            component += c;
+            continue;
+        } else if (!component.empty() && (component != ".")) {
+            if (!result.empty()) {
+                result += '/';
+            }
+            result += component;
+        }
+        component.clear();
+    }
+    return pn::string(result.data(), result.size());
+}
 
-    void file(pn::string_view name, const sfz::Stat& st) const override {
-        name = name.substr(_root_size + 1);
+// Key for looking up a resource path.  Where the filesystem ignores case, so does the index:
+// plugins written there may name "Foo.png" as "foo.png", and still expect to find it.
+pn::string index_key(pn::string_view path) {
+    pn::string key = normalize(path);
+#if defined(__APPLE__) || defined(_WIN32)
+    std::string folded(key.data(), key.size());
+    for (char& c : folded) {
+        if (('A' <= c) && (c <= 'Z')) {
+            c += 'a' - 'A';
+        }
+    }
+    key = pn::string(folded.data(), folded.size());
+#endif
+    return key;
+}
 
-        const int extension_start = name.size() - _extension.size();
-        if ((extension_start <= 0) || (name.substr(extension_start) != _extension)) {
-            return;
+// FNV-1a.
+struct StringHash {
+    size_t operator()(const pn::string& s) const {
+        pn::string_view sv   = s;
+        uint64_t        hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sv.size(); ++i) {
+            hash = (hash ^ static_cast<uint8_t>(sv.data()[i])) * 1099511628211ull;
         }
-        name = name.substr(0, extension_start);
+        return hash;
+    }
+};
 
-        _names->push_back(name.copy());
+// Where a resource lives: under a directory, or in the plugin's zip.
+struct ResourceLocation {
+    const pn::string* dir;        // null if in plug.zip
+    int64_t           zip_index;  // valid if dir is null
+    pn::string        path;       // normalized, in the case that the source uses
+};
+
+// Maps every resource path to the source that provides it.
+//
+// Sources are indexed in override order (plugin directory or zip, then factory scenario, then
+// application data), and the first source to provide a path wins.  After that, finding or
+// checking for a resource is a single hash lookup, with no stat() calls or zip directory searches.
+// Paths are matched as index_key() folds them.
+//
+// The index is built on first use and rebuilt by Resource::mount(), when `plug` changes.
+class ResourceIndex {
+  public:
+    void clear() {
+        _built = false;
+        _entries.clear();
+        _roots.clear();
+    }
+
+    const ResourceLocation* find(pn::string_view resource_path) {
+        if (!_built) {
+            build();
+        }
+        auto it = _entries.find(index_key(resource_path));
+        return (it == _entries.end()) ? nullptr : &it->second;
+    }
+
+    // Names of resources "{dir}/{name}{extension}" from all sources, in sorted order.
+    std::vector<pn::string> list(pn::string_view dir, pn::string_view extension) {
+        return list(dir, extension, false);
     }
 
-    // Ignore non-regular-files:
-    void pre_directory(pn::string_view name, const sfz::Stat& st) const override {}
-    void cycle_directory(pn::string_view name, const sfz::Stat& st) const override {}
-    void post_directory(pn::string_view name, const sfz::Stat& st) const override {}
-    void symlink(pn::string_view name, const sfz::Stat& st) const override {}
-    void broken_symlink(pn::string_view name, const sfz::Stat& st) const override {}
-    void other(pn::string_view name, const sfz::Stat& st) const override {}
+    // As list(), but only from the plugin, or from the application data if there is no plugin.
+    std::vector<pn::string> list_primary(pn::string_view dir, pn::string_view extension) {
+        return list(dir, extension, true);
+    }
 
   private:
-    const int                      _root_size;
-    const pn::string_view          _extension;
-    std::vector<pn::string>* const _names;
-};
+    std::vector<pn::string> list(
+            pn::string_view dir, pn::string_view extension, bool primary_only) {
+        if (!_built) {
+            build();
+        }
+        const pn::string        dir_key       = index_key(dir);
+        const pn::string        extension_key = index_key(extension);
+        const size_t            prefix        = dir_key.size() + 1;
+        std::vector<pn::string> names;
+        for (const auto& kv : _entries) {
+            pn::string_view key = kv.first;
+            if ((key.size() <= (prefix + extension_key.size())) ||
+                (key.substr(0, dir_key.size()) != dir_key) ||
+                (key.data()[dir_key.size()] != '/') ||
+                (key.substr(key.size() - extension_key.size()) != extension_key) ||
+                (primary_only && (kv.second.dir != _primary))) {
+                continue;
+            }
+            pn::string_view path = kv.second.path;
+            names.push_back(
+                    path.substr(prefix, path.size() - prefix - extension_key.size()).copy());
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
 
-class ResourceData {
-  public:
-    static bool exists(pn::string_view dir, pn::string_view resource_path) {
-        return path::isfile(pn::format("{0}/{1}", dir, resource_path));
+    class Walker : public sfz::TreeWalker {
+      public:
+        Walker(ResourceIndex* index, const pn::string* root) : _index(index), _root(root) {}
+
+        void file(pn::string_view name, const sfz::Stat& st) const override {
+            _index->add(name.substr(_root->size() + 1), _root, -1);
+        }
+
+        // Ignore non-regular-files:
+        void pre_directory(pn::string_view name, const sfz::Stat& st) const override {}
+        void cycle_directory(pn::string_view name, const sfz::Stat& st) const override {}
+        void post_directory(pn::string_view name, const sfz::Stat& st) const override {}
+        void symlink(pn::string_view name, const sfz::Stat& st) const override {}
+        void broken_symlink(pn::string_view name, const sfz::Stat& st) const override {}
+        void other(pn::string_view name, const sfz::Stat& st) const override {}
+
+      private:
+        ResourceIndex* const    _index;
+        const pn::string* const _root;
+    };
+
+    void build() {
+        clear();
+        if (plug.dir.has_value()) {
+            _primary = add_dir(*plug.dir);
+        } else if (plug.zip) {
+            _primary = nullptr;
+            for (auto i : sfz::range(plug.zip->size())) {
+                add(plug.zip->name(i), nullptr, i);
+            }
+        }
+        add_dir(factory_scenario_path());
+        const pn::string* app = add_dir(application_path());
+        if (!plug.dir.has_value() && !plug.zip) {
+            _primary = app;
+        }
+        _built = true;
+    }
+
+    const pn::string* add_dir(pn::string_view dir) {
+        _roots.emplace_back(new pn::string(dir.copy()));
+        const pn::string* root = _roots.back().get();
+        for (const char* name : kResourceFiles) {
+            if (path::isfile(pn::format("{0}/{1}", *root, name))) {
+                add(name, root, -1);
+            }
+        }
+        for (const char* name : kResourceDirs) {
+            pn::string subdir = pn::format("{0}/{1}", *root, name);
+            if (path::isdir(subdir)) {
+                sfz::walk(subdir, sfz::WALK_PHYSICAL, Walker(this, root));
+            }
+        }
+        return root;
     }
 
-    static bool exists(const zipxx::ZipArchive& zip, pn::string_view resource_path) {
-        return zip.locate(resource_path.copy().c_str()) != zip.npos;
+    void add(pn::string_view resource_path, const pn::string* dir, int64_t zip_index) {
+        _entries.emplace(
+                index_key(resource_path),
+                ResourceLocation{dir, zip_index, normalize(resource_path)});
     }
 
+    bool                                                         _built   = false;
+    const pn::string*                                            _primary = nullptr;
+    std::vector<std::unique_ptr<pn::string>>                     _roots;
+    std::unordered_map<pn::string, ResourceLocation, StringHash> _entries;
+};
+
+ANTARES_GLOBAL ResourceIndex resource_index;
+
+class ResourceData {
+  public:
     bool load(pn::string_view dir, pn::string_view resource_path) {
         pn::string path = pn::format("{0}/{1}", dir, resource_path);
         if (!path::isfile(path)) {
@@ -111,23 +275,26 @@ class ResourceData {
     }
 
     static bool exists(pn::string_view resource_path) {
-        return (plug.dir.has_value() && exists(*plug.dir, resource_path)) ||
-               (plug.zip && exists(*plug.zip, resource_path)) ||
-               exists(factory_scenario_path(), resource_path) ||
-               exists(application_path(), resource_path);
+        return resource_index.find(resource_path) != nullptr;
     }
 
     static ResourceData load(pn::string_view resource_path) {
+        ANTARES_TRACE_SCOPE("ResourceData::load");
+        const ResourceLocation* location = resource_index.find(resource_path);
+        if (!location) {
+            throw std::runtime_error(pn::format(
+                                             "couldn't find resource {0}",
+                                             pn::dump(resource_path, pn::dump_short))
+                                             .c_str());
+        }
         ResourceData data;
-        if ((plug.dir.has_value() && data.load(*plug.dir, resource_path)) ||
-            (plug.zip && data.load(*plug.zip, resource_path)) ||
-            data.load(factory_scenario_path(), resource_path) ||
-            data.load(application_path(), resource_path)) {
-            return data;
+        if (location->dir) {
+            data._dir_file.reset(
+                    new sfz::mapped_file(pn::format("{0}/{1}", *location->dir, location->path)));
+        } else {
+            data._zip_file.reset(new zipxx::ZipFileReader(*plug.zip, location->zip_index));
         }
-        throw std::runtime_error(
-                pn::format("couldn't find resource {0}", pn::dump(resource_path, pn::dump_short))
-                        .c_str());
+        return data;
     }
 
     static ResourceData load_info() {
@@ -177,47 +344,24 @@ class ResourceData {
     std::unique_ptr<zipxx::ZipFileReader> _zip_file;
 };
 
-static bool startswith(pn::string_view s, pn::string_view prefix) {
-    return (s.size() >= prefix.size()) && (s.substr(0, prefix.size()) == prefix);
-}
-
-static bool endswith(pn::string_view s, pn::string_view suffix) {
-    return (s.size() >= suffix.size()) && (s.substr(s.size() - suffix.size()) == suffix);
-}
-
 }  // namespace
 
-static std::vector<pn::string> list_resources(pn::string_view dir, pn::string_view extension) {
-    std::vector<pn::string> resources;
-    if (plug.dir.has_value()) {
-        pn::string path = pn::format("{0}/{1}", *plug.dir, dir);
-        if (sfz::path::isdir(path)) {
-            sfz::walk(path, sfz::WALK_PHYSICAL, ResourceLister(path, extension, &resources));
-        }
-    } else if (plug.zip) {
-        pn::string prefix = pn::format("{0}/", dir);
-        for (auto i : sfz::range(plug.zip->size())) {
-            pn::string_view name = plug.zip->name(i);
-            if (startswith(name, prefix) && endswith(name, extension)) {
-                resources.push_back(
-                        name.substr(prefix.size(), name.size() - prefix.size() - extension.size())
-                                .copy());
-            }
-        }
-    } else {
-        pn::string path = pn::format("{0}/{1}", application_path(), dir);
-        if (sfz::path::isdir(path)) {
-            sfz::walk(path, sfz::WALK_PHYSICAL, ResourceLister(path, extension, &resources));
-        }
-    }
-    return resources;
+std::vector<pn::string> Resource::list_levels() {
+    return resource_index.list_primary("levels", ".pn");
+}
+std::vector<pn::string> Resource::list_replays() {
+    return resource_index.list_primary("replays", ".NLRP");
 }
-
-std::vector<pn::string> Resource::list_levels() { return list_resources("levels", ".pn"); }
-std::vector<pn::string> Resource::list_replays() { return list_resources("replays", ".NLRP"); }
 
 static pn::value procyon(pn::string_view path) {
-    pn::value  x;
+    pn::value x;
+    if (plug.compiled) {
+        // The cache is keyed by each resource's path as its source spells it.
+        const ResourceLocation* location = resource_index.find(path);
+        if (location && plug.compiled->get(location->path, &x)) {
+            return x;
+        }
+    }
     pn_error_t e;
     if (!pn::parse(ResourceData::load(path).data().input(), &x, &e)) {
         throw std::runtime_error(
@@ -262,14 +406,14 @@ static Texture load_hidpi_texture(pn::string_view name) {
             pn::format("couldn't find picture {0}", pn::dump(name, pn::dump_short)).c_str());
 }
 
-static SoundData load_audio(pn::string_view name) {
+static std::unique_ptr<AudioStream> open_audio(pn::string_view name) {
     static const struct {
         const char ext[6];
-        SoundData (*fn)(pn::data_view);
+        std::unique_ptr<AudioStream> (*fn)(pn::data);
     } fmts[] = {
-            {".aiff", sndfile::convert},
-            {".s3m", modplug::convert},
-            {".xm", modplug::convert},
+            {".aiff", sndfile::stream},
+            {".s3m", modplug::stream},
+            {".xm", modplug::stream},
     };
 
     for (const auto& fmt : fmts) {
@@ -278,7 +422,7 @@ static SoundData load_audio(pn::string_view name) {
             continue;
         }
         try {
-            return fmt.fn(ResourceData::load(path).data());
+            return fmt.fn(ResourceData::load(path).data().copy());
         } catch (...) {
             std::throw_with_nested(std::runtime_error(path.c_str()));
         }
@@ -287,6 +431,8 @@ static SoundData load_audio(pn::string_view name) {
             pn::format("couldn't find sound {0}", pn::dump(name, pn::dump_short)).c_str());
 }
 
+static SoundData load_audio(pn::string_view name) { return read_all(open_audio(name).get()); }
+
 bool Resource::object_exists(pn::string_view name) {
     return ResourceData::exists(pn::format("objects/{0}.pn", name));
 }
@@ -324,10 +470,23 @@ Level Resource::level(pn::string_view name) {
     }
 }
 
+LevelInfo Resource::level_info(pn::string_view name) {
+    pn::string path = pn::format("levels/{0}.pn", name);
+    try {
+        return ::antares::level_info(procyon(path));
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error(path.c_str()));
+    }
+}
+
 SoundData Resource::music(pn::string_view name) {
     return load_audio(pn::format("music/{0}", name));
 }
 
+std::unique_ptr<AudioStream> Resource::music_stream(pn::string_view name) {
+    return open_audio(pn::format("music/{0}", name));
+}
+
 static void merge_value(pn::value_ref base, pn::value_cref patch) {
     switch (patch.type()) {
         case PN_NULL:
@@ -343,9 +502,11 @@ static void merge_value(pn::value_ref base, pn::value_cref patch) {
     pn::map_ref m = base.to_map();
     for (pn::key_value_cref kv : patch.as_map()) {
         pn::string_view k = kv.key();
-        if (m.has(k)) {
+        if (m.has(k) && kv.value().is_map()) {
+            // Only a map patch needs the existing value; anything else replaces it outright,
+            // without copying the subtree it replaces.
             pn::value v = m.get(k).copy();
-            merge_value(v, patch.as_map().get(k));
+            merge_value(v, kv.value());
             m.set(k, std::move(v));
         } else {
             m.set(k, kv.value().copy());
@@ -353,6 +514,27 @@ static void merge_value(pn::value_ref base, pn::value_cref patch) {
     }
 }
 
+// Templates merged so far, by name.  Many objects share a template (and templates share their
+// own templates), so each is read and merged once, and each object merge starts from a copy of
+// its template's final value instead of walking the whole template chain again.
+//
+// Cleared by Resource::mount(), since another plugin may define the same names differently.
+static ANTARES_GLOBAL std::map<pn::string, pn::value> merged_templates;
+static ANTARES_GLOBAL memory::Charge                  merged_templates_charge{memory::PROCYON};
+
+static pn::value merged_object(pn::string_view name);
+
+static pn::value_cref merged_template(pn::string_view name) {
+    auto it = merged_templates.find(name.copy());
+    if (it == merged_templates.end()) {
+        pn::value x = merged_object(name);
+        it          = merged_templates.emplace(name.copy(), std::move(x)).first;
+        merged_templates_charge.reset(
+                merged_templates_charge.bytes() + memory::size_of(it->second));
+    }
+    return it->second;
+}
+
 static pn::value merged_object(pn::string_view name) {
     pn::string path = pn::format("objects/{0}.pn", name);
     try {
@@ -361,7 +543,7 @@ static pn::value merged_object(pn::string_view name) {
         if (!x.is_map() || !x.to_map().pop("template", &tpl) || tpl.is_null()) {
             return x;
         } else if (tpl.is_string()) {
-            pn::value base = merged_object(tpl.as_string());
+            pn::value base = merged_template(tpl.as_string()).copy();
             merge_value(base, x);
             return base;
         } else {
@@ -372,6 +554,48 @@ static pn::value merged_object(pn::string_view name) {
     }
 }
 
+// Bump kCompilerVersion whenever compile() would produce different values from the same data:
+// for example, when merge_value() changes how templates are merged.  Caches written by other
+// versions are then ignored.
+static const uint32_t kCompilerVersion = 1;
+
+// Compiles everything that might be loaded through procyon(), from every source, into a
+// PluginCache.  Resources that fail to parse are left out, so that their errors are reported if
+// and when they are used; other failures, like std::bad_alloc, propagate.
+static std::unique_ptr<PluginCache> compile() {
+    static const struct {
+        const char dir[11];
+        bool       merge;
+    } kDirs[] = {
+            {"fonts", false},  {"interfaces", false}, {"levels", false},
+            {"objects", true}, {"races", false},      {"strings", false},
+    };
+
+    PluginCache::Builder builder;
+    for (const auto& d : kDirs) {
+        for (pn::string_view name : resource_index.list(d.dir, ".pn")) {
+            pn::string path = pn::format("{0}/{1}.pn", d.dir, name);
+            try {
+                builder.add(path, d.merge ? merged_object(name) : procyon(path));
+            } catch (std::runtime_error& e) {
+                continue;
+            }
+        }
+    }
+    return builder.finish(plug.digest, kCompilerVersion);
+}
+
+void Resource::mount() {
+    resource_index.clear();
+    merged_templates.clear();
+    merged_templates_charge.reset(0);
+    plug.sounds   = nullptr;
+    plug.compiled = PluginCache::open(plug.digest, kCompilerVersion);
+    if (!plug.compiled) {
+        plug.compiled = compile();
+    }
+}
+
 BaseObject Resource::object(pn::string_view name) {
     pn::value x = merged_object(name);
     try {
@@ -438,6 +662,12 @@ SoundData Resource::sound(pn::string_view name) {
     return load_audio(pn::format("sounds/{0}", name));
 }
 
+std::vector<pn::string> Resource::list_sounds() { return resource_index.list("sounds", ".aiff"); }
+
+std::unique_ptr<AudioStream> Resource::sound_stream(pn::string_view name) {
+    return open_audio(pn::format("sounds/{0}", name));
+}
+
 SpriteData Resource::sprite_data(pn::string_view name) {
     pn::string path = pn::format("sprites/{0}.pn", name);
     try {
@@ -0,0 +1,252 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/sound-bank.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <thread>
+#include <vector>
+
+#include "config/dirs.hpp"
+#include "data/cache-file.hpp"
+#include "data/plugin.hpp"
+#include "data/resource.hpp"
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+// Bump kVersion whenever the layout below changes.  The version is written in native byte order,
+// so a bank written on a machine of the other endianness is also rejected.
+//
+// Layout:
+//   Header
+//   Record[header.count], each followed by:
+//     char     name[record.name_size], padded to 4 bytes
+//     int16_t  samples[record.data_size / 2], padded to 4 bytes
+const char     kMagic[8] = {'A', 'N', 'T', 'S', 'N', 'D', 'S', '\n'};
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+};
+
+struct Record {
+    uint32_t name_size;
+    uint32_t data_size;
+    int32_t  channels;
+    int32_t  frequency;
+};
+
+// Keeps samples 4-byte aligned within a page-aligned mapping.
+static_assert(sizeof(Header) == 16, "unexpected sound bank header size");
+static_assert(sizeof(Record) == 16, "unexpected sound bank record size");
+
+const int kMaxThreads = 8;
+
+pn::string bank_path(pn::string_view digest) {
+    return pn::format("{0}/{1}/sounds.bin", dirs().cache, digest);
+}
+
+size_t padded(size_t size) { return (size + 3) & ~size_t{3}; }
+
+void append(pn::data& out, const void* bytes, size_t size) {
+    out += pn::data_view{reinterpret_cast<const uint8_t*>(bytes), static_cast<int>(size)};
+    static const uint8_t kZeros[4] = {};
+    out += pn::data_view{kZeros, static_cast<int>(padded(size) - size)};
+}
+
+// Decodes every sound effect.  Resource lookup is not thread-safe, so the streams are opened
+// here, one at a time; only the decoding itself is spread across threads.  A sound that fails to
+// open or decode is left out of the bank; CachedSound will report the error if it is ever played.
+pn::data build() {
+    const std::vector<pn::string>             names = Resource::list_sounds();
+    std::vector<std::unique_ptr<AudioStream>> streams(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        try {
+            streams[i] = Resource::sound_stream(names[i]);
+        } catch (...) {
+            // Left out of the bank.
+        }
+    }
+
+    std::vector<SoundData> sounds(names.size());
+    std::atomic<size_t>    next{0};
+    auto                   decode = [&names, &streams, &sounds, &next] {
+        for (size_t i; (i = next++) < names.size();) {
+            if (streams[i]) {
+                try {
+                    sounds[i] = read_all(streams[i].get());
+                } catch (...) {
+                    // Left out of the bank.  Nothing may escape a worker thread.
+                    sounds[i] = SoundData{};
+                }
+                streams[i].reset();
+            }
+        }
+    };
+    const int threads = std::min<int>(
+            std::max<int>(std::thread::hardware_concurrency(), 1),
+            std::min<size_t>(names.size(), kMaxThreads));
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(decode);
+    }
+    decode();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+
+    Header header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.count   = 0;
+    for (const SoundData& s : sounds) {
+        header.count += (s.data.size() > 0);
+    }
+
+    pn::data out;
+    append(out, &header, sizeof(Header));
+    for (size_t i = 0; i < names.size(); ++i) {
+        const SoundData& s = sounds[i];
+        if (s.data.size() == 0) {
+            continue;
+        }
+        Record record;
+        record.name_size = names[i].size();
+        record.data_size = s.data.size();
+        record.channels  = s.channels;
+        record.frequency = s.frequency;
+        append(out, &record, sizeof(Record));
+        append(out, names[i].data(), names[i].size());
+        append(out, s.data.data(), s.data.size());
+    }
+    return out;
+}
+
+}  // namespace
+
+SoundBank::SoundBank() : _charge(memory::SOUNDS) {}
+SoundBank::~SoundBank() {}
+
+std::unique_ptr<SoundBank> SoundBank::load(pn::string_view digest) {
+    std::unique_ptr<SoundBank> bank(new SoundBank);
+    pn::string                 path = bank_path(digest);
+    try {
+        if (path::isfile(path)) {
+            bank->_file.reset(new sfz::mapped_file(path));
+            bank->_charge = memory::Charge{memory::MAPPED};
+            if (bank->index(bank->_file->data())) {
+                return bank;
+            }
+        }
+    } catch (...) {
+        // Unreadable bank file; fall through and replace it.
+    }
+
+    bank.reset(new SoundBank);
+    bank->_owned = build();
+
+    try {
+        write_cache_file(path, bank->_owned);
+    } catch (...) {
+        // The bank is only an optimization; serve this session from memory.
+    }
+
+    if (!bank->index(bank->_owned)) {
+        throw std::runtime_error("failed to index sound bank");
+    }
+    return bank;
+}
+
+bool SoundBank::index(pn::data_view data) {
+    _entries.clear();
+    _charge.reset(data.size());
+
+    Header header;
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(Header));
+    if ((memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) || (header.version != kVersion)) {
+        return false;
+    }
+
+    size_t offset = sizeof(Header);
+    for (uint32_t i = 0; i < header.count; ++i) {
+        Record record;
+        if ((data.size() - offset) < sizeof(Record)) {
+            return false;
+        }
+        memcpy(&record, data.data() + offset, sizeof(Record));
+        offset += sizeof(Record);
+
+        const size_t name_size = padded(record.name_size);
+        const size_t data_size = padded(record.data_size);
+        if (((data.size() - offset) < name_size) ||
+            ((data.size() - offset - name_size) < data_size)) {
+            return false;
+        }
+        pn::string_view name{reinterpret_cast<const char*>(data.data() + offset),
+                             static_cast<int>(record.name_size)};
+        offset += name_size;
+        Entry entry{pn::data_view{data.data() + offset, static_cast<int>(record.data_size)},
+                    record.channels, record.frequency};
+        offset += data_size;
+        _entries.emplace(name.copy(), entry);
+    }
+    return offset == static_cast<size_t>(data.size());
+}
+
+const SoundBank::Entry* SoundBank::find(pn::string_view name) const {
+    auto it = _entries.find(name.copy());
+    return (it == _entries.end()) ? nullptr : &it->second;
+}
+
+CachedSound CachedSound::load(pn::string_view name) {
+    if (!plug.sounds && !plug.digest.empty()) {
+        plug.sounds = SoundBank::load(plug.digest);
+    }
+
+    CachedSound sound;
+    if (plug.sounds) {
+        if (const SoundBank::Entry* entry = plug.sounds->find(name)) {
+            sound._data      = entry->data;
+            sound._channels  = entry->channels;
+            sound._frequency = entry->frequency;
+            return sound;
+        }
+    }
+
+    sound._decoded.reset(new SoundData(Resource::sound(name)));
+    sound._data      = sound._decoded->data;
+    sound._channels  = sound._decoded->channels;
+    sound._frequency = sound._decoded->frequency;
+    return sound;
+}
+
+}  // namespace antares
@@ -0,0 +1,180 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/sprite-cache.hpp"
+
+#include <string.h>
+
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/dirs.hpp"
+#include "data/cache-file.hpp"
+#include "data/plugin.hpp"
+#include "data/resource.hpp"
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+// Bump kVersion whenever the layout below changes.  The version is written in native byte order,
+// so a cache written on a machine of the other endianness is also rejected.
+//
+// Layout:
+//   Header
+//   SpriteData::Frame   frames[header.frame_count]
+//   RgbColor            image[header.height][header.width]
+//   RgbColor            overlay[header.height][header.width]
+const char     kMagic[8] = {'A', 'N', 'T', 'S', 'P', 'R', 'T', '\n'};
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t frame_count;
+    int32_t  width;
+    int32_t  height;
+};
+
+// Keeps pixel data 4-byte aligned within a page-aligned mapping.
+static_assert(sizeof(Header) == 24, "unexpected sprite cache header size");
+static_assert(sizeof(SpriteData::Frame) == 24, "unexpected sprite cache frame size");
+static_assert(sizeof(RgbColor) == 4, "unexpected sprite cache pixel size");
+
+// A read-only PixMap over pixels owned by a mapped cache file.
+class MappedPixMap : public PixMap {
+  public:
+    MappedPixMap(Size size, const RgbColor* bytes) : _size(size), _bytes(bytes) {}
+
+    const Size&     size() const override { return _size; }
+    const RgbColor* bytes() const override { return _bytes; }
+    int             row_bytes() const override { return _size.width; }
+
+    RgbColor* mutable_bytes() override {
+        throw std::runtime_error("cached sprite pixels are read-only");
+    }
+
+  private:
+    const Size            _size;
+    const RgbColor* const _bytes;
+};
+
+pn::string cache_path(pn::string_view name) {
+    return pn::format("{0}/{1}/sprites/{2}.bin", dirs().cache, plug.digest, name);
+}
+
+void append(pn::data& out, const void* bytes, size_t size) {
+    out += pn::data_view{reinterpret_cast<const uint8_t*>(bytes), static_cast<int>(size)};
+}
+
+}  // namespace
+
+CachedSprite::CachedSprite() {}
+CachedSprite::~CachedSprite() {}
+
+CachedSprite CachedSprite::load(pn::string_view name) {
+    CachedSprite sprite;
+    if (plug.digest.empty()) {
+        sprite.decode(name);
+        return sprite;
+    }
+
+    pn::string path = cache_path(name);
+    try {
+        if (path::isfile(path) && sprite.map(path)) {
+            return sprite;
+        }
+    } catch (...) {
+        // Unreadable cache file; fall through and replace it.
+    }
+    sprite.decode(name);
+    sprite.store(path);
+    return sprite;
+}
+
+bool CachedSprite::map(pn::string_view path) {
+    std::unique_ptr<sfz::mapped_file> file(new sfz::mapped_file(path));
+    pn::data_view                     data = file->data();
+
+    Header header;
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(Header));
+    if ((memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) || (header.version != kVersion) ||
+        (header.width < 0) || (header.height < 0)) {
+        return false;
+    }
+
+    const size_t frames_size = header.frame_count * sizeof(SpriteData::Frame);
+    const size_t pixel_count = static_cast<size_t>(header.width) * header.height;
+    if (data.size() != (sizeof(Header) + frames_size + (2 * pixel_count * sizeof(RgbColor)))) {
+        return false;
+    }
+
+    const uint8_t* p = data.data() + sizeof(Header);
+    _data.frames.resize(header.frame_count);
+    memcpy(_data.frames.data(), p, frames_size);
+    p += frames_size;
+
+    const Size      size{header.width, header.height};
+    const RgbColor* image = reinterpret_cast<const RgbColor*>(p);
+    _image.reset(new MappedPixMap(size, image));
+    _overlay.reset(new MappedPixMap(size, image + pixel_count));
+    _file = std::move(file);
+    _charge.reset(data.size());
+    return true;
+}
+
+void CachedSprite::decode(pn::string_view name) {
+    _data = Resource::sprite_data(name);
+    _image.reset(new ArrayPixMap(Resource::sprite_image(name)));
+    _overlay.reset(new ArrayPixMap(Resource::sprite_overlay(name)));
+}
+
+void CachedSprite::store(pn::string_view path) const {
+    if (_image->size() != _overlay->size()) {
+        return;  // NatePixTable will reject it; don't cache it.
+    }
+
+    Header header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version     = kVersion;
+    header.frame_count = _data.frames.size();
+    header.width       = _image->size().width;
+    header.height      = _image->size().height;
+
+    pn::data out;
+    append(out, &header, sizeof(Header));
+    append(out, _data.frames.data(), _data.frames.size() * sizeof(SpriteData::Frame));
+    for (const PixMap* pix : {_image.get(), _overlay.get()}) {
+        for (int y = 0; y < header.height; ++y) {
+            append(out, pix->row(y), header.width * sizeof(RgbColor));
+        }
+    }
+
+    try {
+        write_cache_file(path, out);
+    } catch (...) {
+        // The cache is only an optimization; carry on with the decoded sprite.
+    }
+}
+
+}  // namespace antares
@@ -0,0 +1,86 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/display-list.hpp"
+
+#include "drawing/text.hpp"
+#include "game/sys.hpp"
+#include "video/driver.hpp"
+
+namespace antares {
+
+void DisplayList::clear() {
+    _ops.clear();
+    _rects.clear();
+    _colors.clear();
+    _glyphs.clear();
+}
+
+void DisplayList::fill(const Rect& rect, const RgbColor& color) {
+    if (_ops.empty() || (_ops.back().type != Op::RECTS)) {
+        _ops.push_back(Op{Op::RECTS, _rects.size(), _rects.size()});
+    }
+    _rects.push_back(rect);
+    _colors.push_back(color);
+    _ops.back().end = _rects.size();
+}
+
+// Places glyphs as Font::draw() does.
+void DisplayList::text(
+        const Font& font, Point at, pn::string_view string, const RgbColor& color) {
+    if (_ops.empty() || (_ops.back().type != Op::TEXT) || (_ops.back().font != &font)) {
+        Op op{Op::TEXT, _glyphs.size(), _glyphs.size()};
+        op.font = &font;
+        _ops.push_back(op);
+    }
+    at.offset(0, -font.ascent);
+    for (pn::rune rune : string) {
+        const Rect& glyph = font.glyph_rect(rune);
+        if (rune.value() > ' ') {
+            _glyphs.push_back(Glyph{Rect(at, glyph.size()), glyph, color});
+        }
+        at.offset(glyph.width(), 0);
+    }
+    _ops.back().end = _glyphs.size();
+}
+
+void DisplayList::picture(const Texture& texture, Point at) {
+    Op op{Op::PICTURE};
+    op.texture = &texture;
+    op.at      = at;
+    _ops.push_back(op);
+}
+
+void DisplayList::draw() const {
+    for (const Op& op : _ops) {
+        switch (op.type) {
+            case Op::RECTS:
+                sys.video->fill_rects(&_rects[op.begin], &_colors[op.begin], op.end - op.begin);
+                break;
+            case Op::TEXT: {
+                Quads quads(op.font->texture);
+                for (size_t i = op.begin; i < op.end; ++i) {
+                    quads.draw(_glyphs[i].dest, _glyphs[i].source, _glyphs[i].color);
+                }
+            } break;
+            case Op::PICTURE: op.texture->draw(op.at.h, op.at.v); break;
+        }
+    }
+}
+
+}  // namespace antares
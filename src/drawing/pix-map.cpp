@@ -79,11 +79,19 @@ void PixMap::composite(const PixMap& pix) {
     }
 }
 
+static int64_t pixel_bytes(Size size) {
+    return static_cast<int64_t>(size.width) * size.height * sizeof(RgbColor);
+}
+
 ArrayPixMap::ArrayPixMap(int32_t width, int32_t height)
-        : _size(width, height), _bytes(new RgbColor[width * height]) {}
+        : _size(width, height),
+          _bytes(new RgbColor[width * height]),
+          _charge(memory::PIXMAPS, pixel_bytes(_size)) {}
 
 ArrayPixMap::ArrayPixMap(Size size)
-        : _size(size), _bytes(new RgbColor[_size.width * _size.height]) {}
+        : _size(size),
+          _bytes(new RgbColor[_size.width * _size.height]),
+          _charge(memory::PIXMAPS, pixel_bytes(_size)) {}
 
 ArrayPixMap::~ArrayPixMap() {}
 
@@ -96,6 +104,7 @@ void ArrayPixMap::resize(Size new_size) {
     new_pix_map.view(transfer).copy(view(transfer));
     _size = new_size;
     swap(_bytes, new_pix_map._bytes);
+    _charge.swap(new_pix_map._charge);
 }
 
 const Size& ArrayPixMap::size() const { return _size; }
@@ -110,6 +119,7 @@ void ArrayPixMap::swap(ArrayPixMap& other) {
     using std::swap;
     swap(_size, other._size);
     swap(_bytes, other._bytes);
+    _charge.swap(other._charge);
 }
 
 PixMap::View::View(PixMap* pix, const Rect& bounds)
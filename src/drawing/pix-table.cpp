@@ -23,7 +23,7 @@
 #include <pn/output>
 #include <sfz/sfz.hpp>
 
-#include "data/resource.hpp"
+#include "data/sprite-cache.hpp"
 #include "data/sprite-data.hpp"
 #include "drawing/color.hpp"
 #include "game/sys.hpp"
@@ -35,10 +35,39 @@ using std::vector;
 
 namespace antares {
 
+namespace {
+
+ArrayPixMap render(const PixMap& image, const PixMap& overlay, Hue hue) {
+    ArrayPixMap pix(image.size());
+    pix.copy(image);
+    if (hue == Hue::GRAY) {
+        return pix;
+    }
+    for (auto x : range(pix.size().width)) {
+        for (auto y : range(pix.size().height)) {
+            RgbColor over  = overlay.get(x, y);
+            uint8_t  value = over.red;
+            uint8_t  frac  = over.alpha;
+            over           = RgbColor::tint(hue, value);
+            RgbColor under = pix.get(x, y);
+            RgbColor composite;
+            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
+            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
+            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
+            composite.alpha = under.alpha;
+            pix.set(x, y, composite);
+        }
+    }
+    return pix;
+}
+
+}  // namespace
+
 NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
-    SpriteData  data    = Resource::sprite_data(name);
-    ArrayPixMap image   = Resource::sprite_image(name);
-    ArrayPixMap overlay = Resource::sprite_overlay(name);
+    CachedSprite      cached  = CachedSprite::load(name);
+    const SpriteData& data    = cached.data();
+    PixMap&           image   = cached.image();
+    PixMap&           overlay = cached.overlay();
 
     if (image.size() != overlay.size()) {
         throw std::runtime_error("size mismatch between image and overlay");
@@ -48,11 +77,8 @@ NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
         Rect      sprite{frame.left, frame.top, frame.right, frame.bottom};
         Rect      bounds = sprite;
         bounds.offset(-frame.cx, -frame.cy);
-        if (hue == Hue::GRAY) {
-            _frames.emplace_back(bounds, image.view(sprite), name, i);
-        } else {
-            _frames.emplace_back(bounds, image.view(sprite), name, i, overlay.view(sprite), hue);
-        }
+        _frames.emplace_back(
+                name, i, sprite, bounds, image.view(sprite), overlay.view(sprite), hue);
     }
 }
 
@@ -63,50 +89,23 @@ const NatePixTable::Frame& NatePixTable::at(size_t index) const { return _frames
 size_t NatePixTable::size() const { return _size; }
 
 NatePixTable::Frame::Frame(
-        Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-        Hue hue)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    load_overlay(overlay, hue);
-    build(name, frame);
-}
-
-NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    build(name, frame);
+        pn::string_view name, int frame, Rect sprite, Rect bounds, const PixMap& image,
+        const PixMap& overlay, Hue hue)
+        : _name(name.copy()), _sprite(sprite), _bounds(bounds), _hue(hue) {
+    ArrayPixMap pix = render(image, overlay, hue);
+    _texture        = sys.video->texture(pn::format("/sprites/{0}%{1}", name, frame), pix, 1);
 }
 
 NatePixTable::Frame::~Frame() {}
 
-void NatePixTable::Frame::load_image(const PixMap& pix) { _pix_map.copy(pix); }
-
-void NatePixTable::Frame::load_overlay(const PixMap& pix, Hue hue) {
-    for (auto x : range(width())) {
-        for (auto y : range(height())) {
-            RgbColor over  = pix.get(x, y);
-            uint8_t  value = over.red;
-            uint8_t  frac  = over.alpha;
-            over           = RgbColor::tint(hue, value);
-            RgbColor under = _pix_map.get(x, y);
-            RgbColor composite;
-            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
-            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
-            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
-            composite.alpha = under.alpha;
-            _pix_map.set(x, y, composite);
-        }
-    }
-}
-
 uint16_t       NatePixTable::Frame::width() const { return _bounds.width(); }
 uint16_t       NatePixTable::Frame::height() const { return _bounds.height(); }
 Point          NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
-const PixMap&  NatePixTable::Frame::pix_map() const { return _pix_map; }
 const Texture& NatePixTable::Frame::texture() const { return _texture; }
 
-void NatePixTable::Frame::build(pn::string_view name, int frame) {
-    _texture = sys.video->texture(pn::format("/sprites/{0}%{1}", name, frame), _pix_map, 1);
+ArrayPixMap NatePixTable::Frame::pix_map() const {
+    CachedSprite cached = CachedSprite::load(_name);
+    return render(cached.image().view(_sprite), cached.overlay().view(_sprite), _hue);
 }
 
 }  // namespace antares
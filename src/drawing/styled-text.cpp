@@ -26,7 +26,7 @@
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
 #include "drawing/text.hpp"
-#include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "video/driver.hpp"
 
 using std::unique_ptr;
@@ -51,47 +51,130 @@ static auto last(container& c) -> decltype(c.end()) {
     return (it == c.begin()) ? it : --it;
 }
 
-StyledText::StyledText() : _wrap_metrics{sys.fonts.tactical} {}
+// Recently-built layouts, most recently used last.  Layouts with inline pictures hold textures,
+// which must not outlive the video driver, so they are never cached.
+class StyledText::LayoutCache {
+  public:
+    static const size_t kMaxEntries = 64;
+
+    struct Key {
+        Markup      markup;
+        pn::string  text;
+        WrapMetrics metrics;
+        RgbColor    fore_color;
+        RgbColor    back_color;
+
+        bool operator==(const Key& other) const {
+            return (markup == other.markup) && (metrics == other.metrics) &&
+                   (fore_color == other.fore_color) && (back_color == other.back_color) &&
+                   (text == other.text);
+        }
+    };
+
+    std::shared_ptr<const Layout> find(const Key& key) {
+        auto it = std::find_if(_entries.begin(), _entries.end(), [&key](const Entry& e) {
+            return e.first == key;
+        });
+        if (it == _entries.end()) {
+            return nullptr;
+        }
+        std::rotate(it, it + 1, _entries.end());
+        return _entries.back().second;
+    }
+
+    void insert(Key key, std::shared_ptr<const Layout> layout) {
+        if (_entries.size() >= kMaxEntries) {
+            _entries.erase(_entries.begin());
+        }
+        _entries.emplace_back(std::move(key), std::move(layout));
+    }
+
+    void clear() { _entries.clear(); }
+
+  private:
+    typedef std::pair<Key, std::shared_ptr<const Layout>> Entry;
+    std::vector<Entry>                                    _entries;
+};
+
+ANTARES_GLOBAL StyledText::LayoutCache StyledText::layout_cache;
+
+StyledText::StyledText() {}
+
+StyledText::StyledText(std::shared_ptr<const Layout> layout)
+        : _layout(std::move(layout)), _until(_layout->chars.end()) {}
 
 StyledText::~StyledText() {}
 
+StyledText::Layout::Layout(pn::string_view text, WrapMetrics wrap_metrics)
+        : text(text.copy()), wrap_metrics(wrap_metrics) {}
+
 StyledText StyledText::plain(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
-    StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
-    t._text         = text.copy();
-    t._wrap_metrics = metrics;
+    return StyledText(layout(PLAIN, text, metrics, fore_color, back_color));
+}
+
+StyledText StyledText::retro(
+        pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
+    return StyledText(layout(RETRO, text, metrics, fore_color, back_color));
+}
 
-    for (auto it = t._text.begin(), end = t._text.end(); it != end; ++it) {
+StyledText StyledText::interface(
+        pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
+    return StyledText(layout(INTERFACE, text, metrics, fore_color, back_color));
+}
+
+void StyledText::flush_layouts() { layout_cache.clear(); }
+
+std::shared_ptr<const StyledText::Layout> StyledText::layout(
+        Markup markup, pn::string_view text, WrapMetrics metrics, RgbColor fore_color,
+        RgbColor back_color) {
+    LayoutCache::Key key{markup, text.copy(), metrics, fore_color, back_color};
+    if (std::shared_ptr<const Layout> cached = layout_cache.find(key)) {
+        return cached;
+    }
+
+    std::shared_ptr<const Layout> built;
+    switch (markup) {
+        case PLAIN: built = build_plain(text, metrics, fore_color, back_color); break;
+        case RETRO: built = build_retro(text, metrics, fore_color, back_color); break;
+        case INTERFACE: built = build_interface(text, metrics, fore_color, back_color); break;
+    }
+    if (built->textures.empty()) {
+        layout_cache.insert(std::move(key), built);
+    }
+    return built;
+}
+
+std::unique_ptr<StyledText::Layout> StyledText::build_plain(
+        pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
+    std::unique_ptr<Layout> t(new Layout(text, metrics));
+
+    for (auto it = t->text.begin(), end = t->text.end(); it != end; ++it) {
         const auto r = *it;
         switch (r.value()) {
             case '\n':
-                t._chars->emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
+                t->chars.emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
                 break;
             case ' ':
-                t._chars->emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
+                t->chars.emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
                 break;
             case 0xA0:
-                t._chars->emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
+                t->chars.emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
                 break;
-            default: t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color)); break;
+            default: t->chars.emplace(it, StyledChar(NONE, 0, fore_color, back_color)); break;
         }
     }
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
+    if (t->chars.empty() || (last(t->chars)->second.special != LINE_BREAK)) {
+        t->chars.emplace(t->text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
     }
-    t._until = t._chars->end();
 
-    t.rewrap();
+    t->rewrap();
     return t;
 }
 
-StyledText StyledText::retro(
+std::unique_ptr<StyledText::Layout> StyledText::build_retro(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
-    StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
-    t._text         = text.copy();
-    t._wrap_metrics = metrics;
+    std::unique_ptr<Layout> t(new Layout(text, metrics));
 
     const RgbColor original_fore_color = fore_color;
     const RgbColor original_back_color = back_color;
@@ -99,31 +182,31 @@ StyledText StyledText::retro(
 
     enum { START, SLASH, FG1, FG2, BG1, BG2 } state = START;
 
-    for (auto it = t._text.begin(), end = t._text.end(); it != end; ++it) {
+    for (auto it = t->text.begin(), end = t->text.end(); it != end; ++it) {
         const auto r = *it;
         switch (state) {
             case START:
                 switch (r.value()) {
                     case '\n':
-                        t._chars->emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
                         break;
 
                     case '_':
                         // TODO(sfiera): replace use of "_" with e.g. "\_".
-                        t._chars->emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
                         break;
 
                     case ' ':
-                        t._chars->emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
                         break;
 
                     case '\\':
                         state = SLASH;
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
                         break;
 
                     default:
-                        t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(NONE, 0, fore_color, back_color));
                         break;
                 }
                 break;
@@ -132,36 +215,36 @@ StyledText StyledText::retro(
                 switch (r.value()) {
                     case 'i':
                         std::swap(fore_color, back_color);
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
                         state = START;
                         break;
 
                     case 'r':
                         fore_color = original_fore_color;
                         back_color = original_back_color;
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t->chars.emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
                         state = START;
                         break;
 
                     case 't':
-                        t._chars->erase(last(*t._chars));
-                        t._chars->emplace(it, StyledChar(TAB, 0, fore_color, back_color));
+                        t->chars.erase(last(t->chars));
+                        t->chars.emplace(it, StyledChar(TAB, 0, fore_color, back_color));
                         state = START;
                         break;
 
                     case '\\':
-                        t._chars->erase(last(*t._chars));
-                        t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color));
+                        t->chars.erase(last(t->chars));
+                        t->chars.emplace(it, StyledChar(NONE, 0, fore_color, back_color));
                         state = START;
                         break;
 
                     case 'f':
-                        t._chars->erase(last(*t._chars));
+                        t->chars.erase(last(t->chars));
                         state = FG1;
                         break;
 
                     case 'b':
-                        t._chars->erase(last(*t._chars));
+                        t->chars.erase(last(t->chars));
                         state = BG1;
                         break;
 
@@ -191,35 +274,31 @@ StyledText StyledText::retro(
         throw std::runtime_error(pn::format("not enough input for special code.").c_str());
     }
 
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
+    if (t->chars.empty() || (last(t->chars)->second.special != LINE_BREAK)) {
+        t->chars.emplace(t->text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
     }
-    t._until = t._chars->end();
 
-    t.rewrap();
+    t->rewrap();
     return t;
 }
 
-StyledText StyledText::interface(
+std::unique_ptr<StyledText::Layout> StyledText::build_interface(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
-    StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
-    t._text         = text.copy();
-    t._wrap_metrics = metrics;
+    std::unique_ptr<Layout> t(new Layout(text, metrics));
 
     const auto f = fore_color;
     const auto b = back_color;
     pn::string id;
     enum { START, CODE, ID } state = START;
 
-    for (auto it = t._text.begin(), end = t._text.end(); it != end; ++it) {
+    for (auto it = t->text.begin(), end = t->text.end(); it != end; ++it) {
         const auto r = *it;
         switch (state) {
             case START:
                 switch (r.value()) {
-                    case '\n': t._chars->emplace(it, StyledChar(LINE_BREAK, 0, f, b)); break;
-                    case ' ': t._chars->emplace(it, StyledChar(WORD_BREAK, 0, f, b)); break;
-                    default: t._chars->emplace(it, StyledChar(NONE, 0, f, b)); break;
+                    case '\n': t->chars.emplace(it, StyledChar(LINE_BREAK, 0, f, b)); break;
+                    case ' ': t->chars.emplace(it, StyledChar(WORD_BREAK, 0, f, b)); break;
+                    default: t->chars.emplace(it, StyledChar(NONE, 0, f, b)); break;
                     case '^': state = CODE; break;
                 }
                 break;
@@ -247,87 +326,91 @@ StyledText StyledText::interface(
                     inline_pict.picture = std::move(id);
                 }
 
-                t._textures.push_back(Resource::texture(inline_pict.picture));
-                inline_pict.bounds = t._textures.back().size().as_rect();
-                t._inline_picts.emplace_back(std::move(inline_pict));
-                t._chars->emplace(it, StyledChar(PICTURE, t._inline_picts.size() - 1, f, b));
+                t->textures.push_back(Resource::texture(inline_pict.picture));
+                inline_pict.bounds = t->textures.back().size().as_rect();
+                t->inline_picts.emplace_back(std::move(inline_pict));
+                t->chars.emplace(it, StyledChar(PICTURE, t->inline_picts.size() - 1, f, b));
                 id.clear();
                 state = START;
                 break;
         }
     }
 
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, f, b));
+    if (t->chars.empty() || (last(t->chars)->second.special != LINE_BREAK)) {
+        t->chars.emplace(t->text.end(), StyledChar(LINE_BREAK, 0, f, b));
     }
-    t._until = t._chars->end();
 
-    t.rewrap();
+    t->rewrap();
     return t;
 }
 
-bool StyledText::done() const { return _chars ? _until == _chars->end() : true; }
-void StyledText::hide() { _until = _chars ? _chars->begin() : decltype(_until){}; }
+bool StyledText::done() const { return _layout ? _until == _layout->chars.end() : true; }
+void StyledText::hide() { _until = _layout ? _layout->chars.begin() : decltype(_until){}; }
 void StyledText::advance() {
     if (!done()) {
         ++_until;
     }
 }
 
-pn::string_view     StyledText::text() const { return _text; }
+pn::string_view     StyledText::text() const { return _layout ? _layout->text : ""; }
 void                StyledText::select(int from, int to) { _selection = {from, to}; }
 std::pair<int, int> StyledText::selection() const { return _selection; }
 void                StyledText::mark(int from, int to) { _mark = {from, to}; }
 std::pair<int, int> StyledText::mark() const { return _mark; }
 
-void StyledText::rewrap() {
-    if (_wrap_metrics.tab_width <= 0) {
-        _wrap_metrics.tab_width = _wrap_metrics.width / 2;
+void StyledText::Layout::rewrap() {
+    if (wrap_metrics.tab_width <= 0) {
+        wrap_metrics.tab_width = wrap_metrics.width / 2;
     }
 
-    _auto_size = Size{0, 0};
-    int h      = _wrap_metrics.side_margin;
-    int v      = 0;
+    auto_size = Size{0, 0};
+    int h     = wrap_metrics.side_margin;
+    int v     = 0;
 
-    const int line_height   = _wrap_metrics.font->height + _wrap_metrics.line_spacing;
-    const int wrap_distance = _wrap_metrics.width - _wrap_metrics.side_margin;
+    const int line_height   = wrap_metrics.font->height + wrap_metrics.line_spacing;
+    const int wrap_distance = wrap_metrics.width - wrap_metrics.side_margin;
 
-    for (auto it = _chars->begin(), end = _chars->end(); it != end; ++it) {
+    for (auto it = chars.begin(), end = chars.end(); it != end; ++it) {
         StyledChar& ch = it->second;
         ch.bounds      = Rect{h, v, h, v + line_height};
         switch (ch.special) {
             case NONE:
+                if ((*it->first).value() > ' ') {
+                    ch.glyph.emplace(wrap_metrics.font->glyph_rect(*it->first));
+                }
+                // fall through
+
             case NO_BREAK:
-                h += _wrap_metrics.font->char_width(*it->first);
+                h += wrap_metrics.font->char_width(*it->first);
                 if (h >= wrap_distance) {
-                    v += _wrap_metrics.font->height + _wrap_metrics.line_spacing;
+                    v += wrap_metrics.font->height + wrap_metrics.line_spacing;
                     h = move_word_down(it, v);
                 }
-                _auto_size.width = std::max(_auto_size.width, h);
+                auto_size.width = std::max(auto_size.width, h);
                 break;
 
             case TAB:
-                h += _wrap_metrics.tab_width - (h % _wrap_metrics.tab_width);
-                _auto_size.width = std::max(_auto_size.width, h);
+                h += wrap_metrics.tab_width - (h % wrap_metrics.tab_width);
+                auto_size.width = std::max(auto_size.width, h);
                 break;
 
             case LINE_BREAK:
-                h = _wrap_metrics.side_margin;
-                v += _wrap_metrics.font->height + _wrap_metrics.line_spacing;
+                h = wrap_metrics.side_margin;
+                v += wrap_metrics.font->height + wrap_metrics.line_spacing;
                 break;
 
-            case WORD_BREAK: h += _wrap_metrics.font->char_width(*it->first); break;
+            case WORD_BREAK: h += wrap_metrics.font->char_width(*it->first); break;
 
             case PICTURE: {
-                inlinePictType* pict = &_inline_picts[ch.pict_index];
-                if (h != _wrap_metrics.side_margin) {
-                    v += _wrap_metrics.font->height + _wrap_metrics.line_spacing;
+                inlinePictType* pict = &inline_picts[ch.pict_index];
+                if (h != wrap_metrics.side_margin) {
+                    v += wrap_metrics.font->height + wrap_metrics.line_spacing;
                 }
-                h = _wrap_metrics.side_margin;
+                h = wrap_metrics.side_margin;
                 pict->bounds.offset(0, v - pict->bounds.top);
-                v += pict->bounds.height() + _wrap_metrics.line_spacing + 3;
+                v += pict->bounds.height() + wrap_metrics.line_spacing + 3;
                 if (next(it)->second.special == LINE_BREAK) {
-                    v -= (_wrap_metrics.font->height + _wrap_metrics.line_spacing);
+                    v -= (wrap_metrics.font->height + wrap_metrics.line_spacing);
                 }
             } break;
 
@@ -335,26 +418,32 @@ void StyledText::rewrap() {
         }
         ch.bounds.right = h;
     }
-    _auto_size.height = v;
+    auto_size.height = v;
 }
 
 bool StyledText::empty() const {
-    return _chars ? _chars->size() <= 1 : true;  // Always have \n at the end.
+    return _layout ? _layout->chars.size() <= 1 : true;  // Always have \n at the end.
 }
 
-int StyledText::height() const { return _auto_size.height; }
+int StyledText::height() const { return _layout ? _layout->auto_size.height : 0; }
 
-int StyledText::auto_width() const { return _auto_size.width; }
+int StyledText::auto_width() const { return _layout ? _layout->auto_size.width : 0; }
 
-const std::vector<inlinePictType>& StyledText::inline_picts() const { return _inline_picts; }
+const std::vector<inlinePictType>& StyledText::inline_picts() const {
+    static const std::vector<inlinePictType> none;
+    return _layout ? _layout->inline_picts : none;
+}
 
 void StyledText::draw(const Rect& bounds) const {
-    const Point char_adjust = {
-            bounds.left, bounds.top + _wrap_metrics.font->ascent + _wrap_metrics.line_spacing};
+    if (!_layout) {
+        return;
+    }
+    const WrapMetrics& metrics      = _layout->wrap_metrics;
+    const Point        glyph_origin = {bounds.left, bounds.top + metrics.line_spacing};
 
     {
         Rects rects;
-        for (auto it = _chars->begin(); it != _until; ++it) {
+        for (auto it = _layout->chars.begin(); it != _until; ++it) {
             const StyledChar& ch = it->second;
             Rect              r  = ch.bounds;
             r.offset(bounds.left, bounds.top);
@@ -385,9 +474,10 @@ void StyledText::draw(const Rect& bounds) const {
         }
 
         if ((0 <= _selection.first) && (_selection.first == _selection.second) &&
-            (_selection.second < _text.size())) {
-            auto it = _chars->lower_bound(
-                    pn::string::iterator{_text.data(), _text.size(), _selection.first});
+            (_selection.second < _layout->text.size())) {
+            const pn::string& text = _layout->text;
+            auto              it   = _layout->chars.lower_bound(
+                    pn::string::iterator{text.data(), text.size(), _selection.first});
             const StyledChar& ch = it->second;
             Rect              r  = ch.bounds;
             r.offset(bounds.left, bounds.top);
@@ -396,38 +486,39 @@ void StyledText::draw(const Rect& bounds) const {
     }
 
     {
-        Quads quads(_wrap_metrics.font->texture);
+        Quads quads(metrics.font->texture);
 
-        for (auto it = _chars->begin(); it != _until; ++it) {
+        for (auto it = _layout->chars.begin(); it != _until; ++it) {
             const StyledChar& ch = it->second;
-            if (ch.special == NONE) {
+            if (ch.glyph.has_value()) {
                 RgbColor color = is_selected(it) ? ch.back_color : ch.fore_color;
-                Point    p = Point{ch.bounds.left + char_adjust.h, ch.bounds.top + char_adjust.v};
-                _wrap_metrics.font->draw(quads, p, *it->first, color);
+                Point    p = Point{ch.bounds.left + glyph_origin.h, ch.bounds.top + glyph_origin.v};
+                quads.draw(Rect(p, ch.glyph->size()), *ch.glyph, color);
             }
         }
     }
 
-    for (auto it = _chars->begin(); it != _until; ++it) {
+    for (auto it = _layout->chars.begin(); it != _until; ++it) {
         const StyledChar& ch     = it->second;
         Point             corner = bounds.origin();
         if (ch.special == PICTURE) {
-            const inlinePictType& inline_pict = _inline_picts[ch.pict_index];
-            const Texture&        texture     = _textures[ch.pict_index];
-            corner.offset(
-                    inline_pict.bounds.left, inline_pict.bounds.top + _wrap_metrics.line_spacing);
+            const inlinePictType& inline_pict = _layout->inline_picts[ch.pict_index];
+            const Texture&        texture     = _layout->textures[ch.pict_index];
+            corner.offset(inline_pict.bounds.left, inline_pict.bounds.top + metrics.line_spacing);
             texture.draw(corner.h, corner.v);
         }
     }
 }
 
 void StyledText::draw_cursor(const Rect& bounds, const RgbColor& color, bool ends) const {
-    if (done() || (!ends && ((_until == _chars->begin()) || (next(_until) == _chars->end())))) {
+    if (done() ||
+        (!ends && ((_until == _layout->chars.begin()) || (next(_until) == _layout->chars.end())))) {
         return;
     }
-    const int         line_height = _wrap_metrics.font->height + _wrap_metrics.line_spacing;
-    const StyledChar& ch          = _until->second;
-    Rect              char_rect(0, 0, _wrap_metrics.font->logicalWidth, line_height);
+    const WrapMetrics& metrics     = _layout->wrap_metrics;
+    const int          line_height = metrics.font->height + metrics.line_spacing;
+    const StyledChar&  ch          = _until->second;
+    Rect               char_rect(0, 0, metrics.font->logicalWidth, line_height);
     char_rect.offset(bounds.left + ch.bounds.left, bounds.top + ch.bounds.top);
     char_rect.clip_to(bounds);
     if ((char_rect.width() > 0) && (char_rect.height() > 0)) {
@@ -481,23 +572,25 @@ static bool is_paragraph_end(
 
 bool StyledText::is_line_start(
         pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it) const {
-    auto curr = _chars->lower_bound(it);
-    if (curr == _chars->begin()) {
+    auto curr = _layout->chars.lower_bound(it);
+    if (curr == _layout->chars.begin()) {
         return true;
     }
-    auto prev =
-            _chars->lower_bound(pn::string::iterator{_text.data(), _text.size(), it.offset() - 1});
+    const pn::string& text = _layout->text;
+    auto prev = _layout->chars.lower_bound(
+            pn::string::iterator{text.data(), text.size(), it.offset() - 1});
     return (curr->second.bounds.top > prev->second.bounds.top);
 }
 
 bool StyledText::is_line_end(
         pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it) const {
-    auto curr = _chars->lower_bound(it);
-    if (curr == _chars->end()) {
+    auto curr = _layout->chars.lower_bound(it);
+    if (curr == _layout->chars.end()) {
         return true;
     }
-    auto next =
-            _chars->lower_bound(pn::string::iterator{_text.data(), _text.size(), it.offset() + 1});
+    const pn::string& text = _layout->text;
+    auto next = _layout->chars.lower_bound(
+            pn::string::iterator{text.data(), text.size(), it.offset() + 1});
     return (curr->second.bounds.top < next->second.bounds.top);
 }
 
@@ -524,20 +617,20 @@ bool StyledText::is_end(
 }
 
 pn::string::iterator StyledText::line_up(pn::string::iterator it) const {
-    auto          curr = _chars->lower_bound(it);
+    auto          curr = _layout->chars.lower_bound(it);
     const int32_t h    = curr->second.bounds.left;
     const int32_t v    = curr->second.bounds.top;
-    while ((curr != _chars->begin()) && (curr->second.bounds.top == v)) {
+    while ((curr != _layout->chars.begin()) && (curr->second.bounds.top == v)) {
         --curr;
     }
-    if (curr == _chars->begin()) {
+    if (curr == _layout->chars.begin()) {
         return curr->first;
     }
 
     const int32_t v2      = curr->second.bounds.top;
     auto          closest = curr;
     int32_t       diff    = std::abs(h - curr->second.bounds.left);
-    while ((curr != _chars->begin()) && (curr->second.bounds.top == v2)) {
+    while ((curr != _layout->chars.begin()) && (curr->second.bounds.top == v2)) {
         int32_t diff2 = std::abs(h - curr->second.bounds.left);
         if (diff2 <= diff) {
             closest = curr;
@@ -551,13 +644,13 @@ pn::string::iterator StyledText::line_up(pn::string::iterator it) const {
 }
 
 pn::string::iterator StyledText::line_down(pn::string::iterator it) const {
-    auto          curr = _chars->lower_bound(it);
+    auto          curr = _layout->chars.lower_bound(it);
     const int32_t h    = curr->second.bounds.left;
     const int32_t v    = curr->second.bounds.top;
-    while ((curr != _chars->end()) && (curr->second.bounds.top == v)) {
+    while ((curr != _layout->chars.end()) && (curr->second.bounds.top == v)) {
         ++curr;
     }
-    if (curr == _chars->end()) {
+    if (curr == _layout->chars.end()) {
         --curr;
         return curr->first;
     }
@@ -565,7 +658,7 @@ pn::string::iterator StyledText::line_down(pn::string::iterator it) const {
     const int32_t v2      = curr->second.bounds.top;
     auto          closest = curr;
     int32_t       diff    = std::abs(h - curr->second.bounds.left);
-    while ((curr != _chars->end()) && (curr->second.bounds.top == v2)) {
+    while ((curr != _layout->chars.end()) && (curr->second.bounds.top == v2)) {
         int32_t diff2 = std::abs(h - curr->second.bounds.left);
         if (diff2 <= diff) {
             closest = curr;
@@ -580,13 +673,17 @@ pn::string::iterator StyledText::line_down(pn::string::iterator it) const {
 
 int StyledText::offset(
         int origin, TextReceiver::Offset offset, TextReceiver::OffsetUnit unit) const {
-    pn::string::iterator       it{_text.data(), _text.size(), origin};
-    const pn::string::iterator begin = _text.begin(), end = _text.end();
+    if (!_layout) {
+        return 0;
+    }
+    const pn::string&          text = _layout->text;
+    pn::string::iterator       it{text.data(), text.size(), origin};
+    const pn::string::iterator begin = text.begin(), end = text.end();
 
     if ((offset < 0) && (it == begin)) {
         return 0;
     } else if ((offset > 0) && (it == end)) {
-        return _text.size();
+        return text.size();
     }
 
     switch (offset) {
@@ -643,26 +740,27 @@ int StyledText::offset(
     }
 }
 
-int StyledText::move_word_down(std::map<pn::string::iterator, StyledChar>::iterator it, int v) {
+int StyledText::Layout::move_word_down(
+        std::map<pn::string::iterator, StyledChar>::iterator it, int v) {
     const auto end = next(it);
     while (true) {
         StyledChar& ch = it->second;
         switch (ch.special) {
             case LINE_BREAK:
-            case PICTURE: return _wrap_metrics.side_margin;
+            case PICTURE: return wrap_metrics.side_margin;
 
             case WORD_BREAK:
             case TAB:
             case DELAY: {
                 ++it;
-                if (it->second.bounds.left <= _wrap_metrics.side_margin) {
-                    return _wrap_metrics.side_margin;
+                if (it->second.bounds.left <= wrap_metrics.side_margin) {
+                    return wrap_metrics.side_margin;
                 }
 
-                int h = _wrap_metrics.side_margin;
+                int h = wrap_metrics.side_margin;
                 for (; it != end; ++it) {
                     it->second.bounds = Rect{Point{h, v}, it->second.bounds.size()};
-                    h += _wrap_metrics.font->char_width(*it->first);
+                    h += wrap_metrics.font->char_width(*it->first);
                 }
                 return h;
             }
@@ -671,12 +769,12 @@ int StyledText::move_word_down(std::map<pn::string::iterator, StyledChar>::itera
             case NONE: break;
         }
 
-        if (it == _chars->begin()) {
+        if (it == chars.begin()) {
             break;
         }
         --it;
     }
-    return _wrap_metrics.side_margin;
+    return wrap_metrics.side_margin;
 }
 
 bool StyledText::is_selected(std::map<pn::string::iterator, StyledChar>::const_iterator it) const {
@@ -46,7 +46,7 @@ enum {
 
 }  // namespace
 
-Font::Font() {}
+Font::Font() : _flat_glyphs(kFlatGlyphs) {}
 
 Font::Font(
         Texture texture, int logical_width, int height, int ascent,
@@ -54,8 +54,21 @@ Font::Font(
         : texture(std::move(texture)),
           logicalWidth(logical_width),
           height(height),
-          ascent(ascent),
-          _glyphs(glyphs) {}
+          ascent(ascent) {
+    auto question = glyphs.find(pn::rune{'?'});
+    if (question != glyphs.end()) {
+        _fallback_glyph = question->second;
+    }
+    _flat_glyphs.assign(kFlatGlyphs, _fallback_glyph);
+    for (const auto& kv : glyphs) {
+        const uint32_t code = kv.first.value();
+        if (code < kFlatGlyphs) {
+            _flat_glyphs[code] = kv.second;
+        } else {
+            _other_glyphs.emplace(code, kv.second);
+        }
+    }
+}
 
 Font font(pn::string_view name) {
     FontData d       = Resource::font(name);
@@ -65,12 +78,9 @@ Font font(pn::string_view name) {
 
 Font::~Font() {}
 
-Rect Font::glyph_rect(pn::rune rune) const {
-    auto it = _glyphs.find(rune);
-    if (it == _glyphs.end()) {
-        return glyph_rect(pn::rune{'?'});
-    }
-    return it->second;
+const Rect& Font::other_glyph_rect(uint32_t code) const {
+    auto it = _other_glyphs.find(code);
+    return (it == _other_glyphs.end()) ? _fallback_glyph : it->second;
 }
 
 void Font::draw(Point cursor, pn::string_view string, RgbColor color) const {
@@ -80,7 +90,7 @@ void Font::draw(Point cursor, pn::string_view string, RgbColor color) const {
 void Font::draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const {
     cursor.offset(0, -ascent);
     for (pn::rune rune : string) {
-        auto glyph = glyph_rect(rune);
+        const Rect& glyph = glyph_rect(rune);
         if (rune.value() > ' ') {
             quads.draw(Rect(cursor, glyph.size()), glyph, color);
         }
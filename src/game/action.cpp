@@ -42,6 +42,7 @@
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/memory.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -832,8 +833,11 @@ void exec(
     execute_actions(ActionCursor(actions, subject, direct, offset));
 }
 
+static ANTARES_GLOBAL memory::Charge action_queue_charge{memory::GAME};
+
 void reset_action_queue() {
     g.action_queue.data.reset(new actionQueueType[kActionQueueLength]);
+    action_queue_charge.reset(kActionQueueLength * sizeof(actionQueueType));
 
     g.action_queue.first = NULL;
 
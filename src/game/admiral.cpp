@@ -26,6 +26,8 @@
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/casts.hpp"
+#include "lang/defines.hpp"
+#include "lang/memory.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/units.hpp"
@@ -68,11 +70,15 @@ static bool could_target(const Admiral& a, const BaseObject& base, const SpaceOb
            tags_match(*target.base, base.ai.target.force.tags);
 }
 
+static ANTARES_GLOBAL memory::Charge admirals_charge{memory::GAME};
+
 void Admiral::init() {
     g.admirals.reset(new Admiral[kMaxPlayerNum]);
     reset();
     g.destinations.reset(new Destination[kMaxDestObject]);
     ResetAllDestObjectData();
+    admirals_charge.reset(
+            (kMaxPlayerNum * sizeof(Admiral)) + (kMaxDestObject * sizeof(Destination)));
 }
 
 void Admiral::reset() {
@@ -20,9 +20,11 @@
 
 #include <algorithm>
 #include <sfz/sfz.hpp>
+#include <vector>
 
 #include "data/base-object.hpp"
 #include "drawing/color.hpp"
+#include "drawing/display-list.hpp"
 #include "drawing/shapes.hpp"
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
@@ -134,6 +136,12 @@ struct SiteData {
     RgbColor light, dark;
 };
 
+// Rects on the instrument panels which depend on only a few values.
+static ANTARES_GLOBAL CachedRects gMoneyRects;
+static ANTARES_GLOBAL CachedRects gBarRects[kBarIndicatorNum];
+static ANTARES_GLOBAL CachedRects gBuildTimeRects;
+static ANTARES_GLOBAL CachedRects gRadarRects;
+
 template <typename T>
 T clamp(T value, T min, T max) {
     if (value < min) {
@@ -338,9 +346,10 @@ void draw_radar() {
     const RgbColor darkest    = GetRGBTranslateColorShade(kRadarColor, DARKEST);
     const RgbColor very_dark  = GetRGBTranslateColorShade(kRadarColor, VERY_DARK);
     if (g.radar_on) {
-        Rect radar = bounds;
-        {
-            Rects rects;
+        if (gRadarRects.update({bounds.left, bounds.top, view_range.left, view_range.top,
+                                view_range.right, view_range.bottom})) {
+            Rects rects(&gRadarRects.list);
+            Rect  radar = bounds;
             rects.fill(radar, very_light);
             radar.inset(1, 1);
             rects.fill(radar, darkest);
@@ -348,6 +357,7 @@ void draw_radar() {
                 rects.fill(view_range, very_dark);
             }
         }
+        gRadarRects.list.draw();
 
         RgbColor color;
         if (g.radar_count <= ticks(0)) {
@@ -416,45 +426,48 @@ static void draw_money() {
         second_threshold   = gBarIndicator[kFineMoneyBar].thisValue;
     }
 
-    Rects rects;
-    for (int i = 0; i < kFineMoneyBarNum; ++i) {
-        if (i < first_threshold) {
-            if ((i % 5) != 0) {
-                rects.fill(box, first_color_minor);
-            } else {
-                rects.fill(box, first_color_major);
-            }
-        } else if (i < second_threshold) {
-            if ((i % 5) != 0) {
-                rects.fill(box, second_color_minor);
+    barIndicatorType* fine  = gBarIndicator + kFineMoneyBar;
+    barIndicatorType* gross = gBarIndicator + kGrossMoneyBar;
+    gross->thisValue        = mFixedToLong(admiral->cash().amount / kGrossMoneyBarValue.amount);
+    if (gMoneyRects.update({fine->thisValue, price, gross->thisValue, box.left, box.top})) {
+        Rects rects(&gMoneyRects.list);
+        for (int i = 0; i < kFineMoneyBarNum; ++i) {
+            if (i < first_threshold) {
+                if ((i % 5) != 0) {
+                    rects.fill(box, first_color_minor);
+                } else {
+                    rects.fill(box, first_color_major);
+                }
+            } else if (i < second_threshold) {
+                if ((i % 5) != 0) {
+                    rects.fill(box, second_color_minor);
+                } else {
+                    rects.fill(box, second_color_major);
+                }
             } else {
-                rects.fill(box, second_color_major);
+                rects.fill(box, third_color);
             }
-        } else {
-            rects.fill(box, third_color);
+            box.offset(0, kFineMoneyBarHeight);
         }
-        box.offset(0, kFineMoneyBarHeight);
-    }
-    gBarIndicator[kFineMoneyBar].thisValue = second_threshold;
 
-    barIndicatorType* gross = gBarIndicator + kGrossMoneyBar;
-    gross->thisValue        = mFixedToLong(admiral->cash().amount / kGrossMoneyBarValue.amount);
+        box = Rect(0, 0, kGrossMoneyBarWidth, kGrossMoneyBarHeight - 1);
+        box.offset(
+                play_screen().right + kGrossMoneyLeft + kGrossMoneyHBuffer,
+                kGrossMoneyTop + instrument_top() + kGrossMoneyVBuffer);
 
-    box = Rect(0, 0, kGrossMoneyBarWidth, kGrossMoneyBarHeight - 1);
-    box.offset(
-            play_screen().right + kGrossMoneyLeft + kGrossMoneyHBuffer,
-            kGrossMoneyTop + instrument_top() + kGrossMoneyVBuffer);
-
-    const RgbColor light = GetRGBTranslateColorShade(kGrossMoneyColor, LIGHTEST);
-    const RgbColor dark  = GetRGBTranslateColorShade(kGrossMoneyColor, VERY_DARK);
-    for (int i = 0; i < kGrossMoneyBarNum; ++i) {
-        if (i < gross->thisValue) {
-            rects.fill(box, light);
-        } else {
-            rects.fill(box, dark);
+        const RgbColor light = GetRGBTranslateColorShade(kGrossMoneyColor, LIGHTEST);
+        const RgbColor dark  = GetRGBTranslateColorShade(kGrossMoneyColor, VERY_DARK);
+        for (int i = 0; i < kGrossMoneyBarNum; ++i) {
+            if (i < gross->thisValue) {
+                rects.fill(box, light);
+            } else {
+                rects.fill(box, dark);
+            }
+            box.offset(0, kGrossMoneyBarHeight);
         }
-        box.offset(0, kGrossMoneyBarHeight);
     }
+    gMoneyRects.list.draw();
+    fine->thisValue = second_threshold;
 }
 
 void set_up_instruments() {
@@ -635,7 +648,6 @@ void draw_arbitrary_sector_lines(
 }
 
 static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
-    Rects rects;
     if (value > max) {
         value = max;
     }
@@ -656,23 +668,28 @@ static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
     Rect bar(0, 0, kBarIndicatorWidth, kBarIndicatorHeight);
     bar.offset(
             kBarIndicatorLeft + play_screen().right, gBarIndicator[which].top + instrument_top());
-    if (graphicValue < kBarIndicatorHeight) {
-        Rect top_bar               = bar;
-        top_bar.bottom             = top_bar.bottom - graphicValue;
-        const RgbColor fill_color  = GetRGBTranslateColorShade(hue, DARK);
-        const RgbColor light_color = GetRGBTranslateColorShade(hue, MEDIUM);
-        const RgbColor dark_color  = GetRGBTranslateColorShade(hue, DARKER);
-        draw_shaded_rect(rects, top_bar, fill_color, light_color, dark_color);
-    }
+    CachedRects& cache = gBarRects[which];
+    if (cache.update({graphicValue, bar.left, bar.top})) {
+        Rects rects(&cache.list);
+        if (graphicValue < kBarIndicatorHeight) {
+            Rect top_bar               = bar;
+            top_bar.bottom             = top_bar.bottom - graphicValue;
+            const RgbColor fill_color  = GetRGBTranslateColorShade(hue, DARK);
+            const RgbColor light_color = GetRGBTranslateColorShade(hue, MEDIUM);
+            const RgbColor dark_color  = GetRGBTranslateColorShade(hue, DARKER);
+            draw_shaded_rect(rects, top_bar, fill_color, light_color, dark_color);
+        }
 
-    if (graphicValue > 0) {
-        Rect bottom_bar            = bar;
-        bottom_bar.top             = bottom_bar.bottom - graphicValue;
-        const RgbColor fill_color  = GetRGBTranslateColorShade(hue, LIGHTER);
-        const RgbColor light_color = GetRGBTranslateColorShade(hue, LIGHTEST);
-        const RgbColor dark_color  = GetRGBTranslateColorShade(hue, MEDIUM);
-        draw_shaded_rect(rects, bottom_bar, fill_color, light_color, dark_color);
+        if (graphicValue > 0) {
+            Rect bottom_bar            = bar;
+            bottom_bar.top             = bottom_bar.bottom - graphicValue;
+            const RgbColor fill_color  = GetRGBTranslateColorShade(hue, LIGHTER);
+            const RgbColor light_color = GetRGBTranslateColorShade(hue, LIGHTEST);
+            const RgbColor dark_color  = GetRGBTranslateColorShade(hue, MEDIUM);
+            draw_shaded_rect(rects, bottom_bar, fill_color, light_color, dark_color);
+        }
     }
+    cache.list.draw();
 
     gBarIndicator[which].thisValue = value;
 }
@@ -688,29 +705,31 @@ void draw_build_time_bar() {
         value = build_at->buildTime * kMiniBuildTimeHeight / build_at->totalBuildTime;
     }
 
-    Rects rects;
     value = kMiniBuildTimeHeight - value;
 
     const Rect clip = mini_build_time_rect();
+    if (gBuildTimeRects.update({value, clip.left, clip.top})) {
+        Rects rects(&gBuildTimeRects.list);
+        {
+            const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, MEDIUM);
+            draw_vbracket(rects, clip, color);
+        }
 
-    {
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, MEDIUM);
-        draw_vbracket(rects, clip, color);
-    }
-
-    Rect bar = clip;
-    bar.inset(2, 2);
+        Rect bar = clip;
+        bar.inset(2, 2);
 
-    {
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, DARK);
-        rects.fill(bar, color);
-    }
+        {
+            const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, DARK);
+            rects.fill(bar, color);
+        }
 
-    if (value > 0) {
-        bar.top += value;
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, LIGHT);
-        rects.fill(bar, color);
+        if (value > 0) {
+            bar.top += value;
+            const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, LIGHT);
+            rects.fill(bar, color);
+        }
     }
+    gBuildTimeRects.list.draw();
 }
 
 }  // namespace antares
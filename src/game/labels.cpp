@@ -29,6 +29,7 @@
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
+#include "lang/memory.hpp"
 #include "video/driver.hpp"
 
 using std::max;
@@ -57,7 +58,12 @@ Label* Label::get(int number) {
     return nullptr;
 }
 
-void Label::init() { g.labels.reset(new Label[kMaxLabelNum]); }
+static ANTARES_GLOBAL memory::Charge labels_charge{memory::GAME};
+
+void Label::init() {
+    g.labels.reset(new Label[kMaxLabelNum]);
+    labels_charge.reset(kMaxLabelNum * sizeof(Label));
+}
 
 void Label::reset() {
     for (auto label : all()) {
@@ -96,15 +102,15 @@ Handle<Label> Label::add(
     } else {
         label->visible = true;
     }
-    label->_text   = StyledText{};
+    label->clear_text();
     label->lineNum = 0;
 
     return label;
 }
 
 void Label::remove() {
+    clear_text();
     thisRect = Rect(0, 0, -1, -1);
-    _text    = StyledText{};
     active   = false;
     killMe   = false;
     object   = SpaceObject::none();
@@ -131,18 +137,28 @@ void Label::draw() {
     }
 }
 
+void Label::set_text(pn::string_view text, WrapMetrics metrics, RgbColor color) {
+    if (_source_metrics.has_value() && (*_source_metrics == metrics) && (_source_color == color) &&
+        (_source_text == text)) {
+        return;
+    }
+    _text        = StyledText::plain(text, metrics, color);
+    _source_text = text.copy();
+    _source_metrics.emplace(metrics);
+    _source_color = color;
+}
+
+void Label::clear_text() {
+    _text        = StyledText{};
+    _source_text = pn::string{};
+    _source_metrics.reset();
+}
+
+// Only advances the text's reveal; thisRect was already placed by update_positions().
 void Label::update_contents(ticks units_done) {
-    Rect clip = viewport();
     for (auto label : all()) {
-        if (!label->active || label->killMe || label->_text.empty() || !label->visible) {
-            label->thisRect.left = label->thisRect.right = 0;
-            continue;
-        }
-
-        label->thisRect = Rect(0, 0, label->width(), label->height());
-        label->thisRect.offset(label->where.h, label->where.v);
-        label->thisRect.clip_to(clip);
-        if ((label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
+        if (!label->active || label->killMe || label->_text.empty() || !label->visible ||
+            (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
             continue;
         }
 
@@ -238,7 +254,7 @@ void Label::update_positions(ticks units_done) {
                         HintLine::show(source, dest, label->hue, DARK);
                     }
                 } else {
-                    label->_text = StyledText{};
+                    label->clear_text();
                     if (label->attachedHintLine) {
                         HintLine::hide();
                     }
@@ -269,7 +285,7 @@ void Label::update_positions(ticks units_done) {
                     label->visible = false;
                     label->age     = ticks(0);
                     label->object  = SpaceObject::none();
-                    label->_text   = StyledText{};
+                    label->clear_text();
                     if (label->attachedHintLine) {
                         HintLine::hide();
                     }
@@ -283,6 +299,18 @@ void Label::update_positions(ticks units_done) {
             }
         }
     }
+
+    const Rect clip = viewport();
+    for (auto label : all()) {
+        if (!label->active || label->killMe || label->_text.empty() || !label->visible) {
+            label->thisRect.left = label->thisRect.right = 0;
+            continue;
+        }
+
+        label->thisRect = Rect(0, 0, label->width(), label->height());
+        label->thisRect.offset(label->where.h, label->where.v);
+        label->thisRect.clip_to(clip);
+    }
 }
 
 void Label::set_object(Handle<SpaceObject> object) {
@@ -41,6 +41,7 @@
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -184,6 +185,7 @@ static void construct_players(const Players& players) {
 }
 
 LoadState start_construct_level(const Level& level) {
+    ANTARES_TRACE_SCOPE("start_construct_level");
     ResetAllSpaceObjects();
     reset_action_queue();
     Vectors::reset();
@@ -195,6 +197,7 @@ LoadState start_construct_level(const Level& level) {
     ResetMotionGlobals();
     plug.races.clear();
     plug.objects.clear();
+    plug.loaded_charge.reset(0);
     gAbsoluteScale = kTimesTwoScale;
     g.sync         = 0;
 
@@ -296,6 +299,7 @@ static void load_condition(Handle<const Condition> condition, std::bitset<16> al
 }
 
 static void run_game_1s() {
+    ANTARES_TRACE_SCOPE("run_game_1s");
     game_ticks start_time = game_ticks(-g.level->base.start_time.value_or(secs(0)));
     do {
         g.time += kMajorTick;
@@ -313,6 +317,7 @@ static void run_game_1s() {
 }
 
 void construct_level(LoadState* state) {
+    ANTARES_TRACE_SCOPE_ARG("construct_level", state->step);
     int32_t         step = state->step;
     std::bitset<16> all_colors;
     all_colors[0] = true;
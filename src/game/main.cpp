@@ -54,6 +54,7 @@
 #include "game/time.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
 #include "math/units.hpp"
 #include "sound/driver.hpp"
 #include "sound/fx.hpp"
@@ -387,19 +388,26 @@ void GamePlay::become_front() {
 void GamePlay::resign_front() { minicomputer_cancel(); }
 
 void GamePlay::draw() const {
+    ANTARES_TRACE_SCOPE("GamePlay::draw");
     globals()->starfield.draw();
     if (_should_draw_sector_lines) {
         draw_sector_lines();
     }
     Vectors::draw();
-    draw_sprites();
+    {
+        ANTARES_TRACE_SCOPE("draw_sprites");
+        draw_sprites();
+    }
     Label::draw();
 
     Messages::draw_message();
     if (_should_draw_site) {
         draw_site(_player_ship);
     }
-    draw_instruments();
+    {
+        ANTARES_TRACE_SCOPE("draw_instruments");
+        draw_instruments();
+    }
     if (stack()->top() == this) {
         _player_ship.cursor().draw();
     }
@@ -445,6 +453,7 @@ void GamePlay::fire_timer() {
     }
 
     while (unitsPassed > ticks(0)) {
+        ANTARES_TRACE_SCOPE_ARG("minor tick", g.time.time_since_epoch() / kMajorTick);
         ticks unitsToDo   = unitsPassed;
         ticks minor_ticks = g.time.time_since_epoch() % kMajorTick;
         if (minor_ticks + unitsToDo > kMajorTick) {
@@ -454,17 +463,30 @@ void GamePlay::fire_timer() {
         // executed arbitrarily, but at least once every major tick
         globals()->starfield.prepare_to_move();
         globals()->starfield.move(unitsToDo);
-        MoveSpaceObjects(unitsToDo);
+        {
+            ANTARES_TRACE_SCOPE("MoveSpaceObjects");
+            MoveSpaceObjects(unitsToDo);
+        }
 
         g.time += unitsToDo;
 
         if ((g.time.time_since_epoch() % kMajorTick) == ticks(0)) {
             // everything in here gets executed once every major tick
+            ANTARES_TRACE_SCOPE_ARG("major tick", g.time.time_since_epoch() / kMajorTick);
             _player_paused = false;
 
-            NonplayerShipThink();
-            AdmiralThink();
-            execute_action_queue();
+            {
+                ANTARES_TRACE_SCOPE("NonplayerShipThink");
+                NonplayerShipThink();
+            }
+            {
+                ANTARES_TRACE_SCOPE("AdmiralThink");
+                AdmiralThink();
+            }
+            {
+                ANTARES_TRACE_SCOPE("execute_action_queue");
+                execute_action_queue();
+            }
 
             if (!_input_source->get(g.admiral, g.time, _player_ship)) {
                 g.game_over    = true;
@@ -472,21 +494,31 @@ void GamePlay::fire_timer() {
             }
             _player_ship.update();
 
-            CollideSpaceObjects();
+            {
+                ANTARES_TRACE_SCOPE("CollideSpaceObjects");
+                CollideSpaceObjects();
+            }
             if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
+                ANTARES_TRACE_SCOPE("CheckLevelConditions");
                 CheckLevelConditions();
             }
         }
 
-        UpdateMiniScreenLines();
+        {
+            ANTARES_TRACE_SCOPE("UpdateMiniScreenLines");
+            UpdateMiniScreenLines();
+        }
 
         Messages::clip();
         Messages::draw_long_message(unitsToDo);
 
         _should_draw_sector_lines = update_sector_lines();
         Vectors::update();
-        Label::update_positions(unitsToDo);
-        Label::update_contents(unitsToDo);
+        {
+            ANTARES_TRACE_SCOPE("Label::update");
+            Label::update_positions(unitsToDo);
+            Label::update_contents(unitsToDo);
+        }
         _should_draw_site = update_site();
 
         CullSprites();
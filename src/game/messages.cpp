@@ -311,18 +311,17 @@ void Messages::draw_message_screen(ticks by_units) {
                     viewport().bottom - (kMessageDisplayTime - time_count).count());
         }
 
-        g.message_label->text() = StyledText::plain(
+        g.message_label->set_text(
                 message, sys.fonts.tactical, GetRGBTranslateColorShade(kMessageColor, LIGHTEST));
     } else {
-        g.message_label->text() = StyledText{};
-        time_count              = ticks(0);
+        g.message_label->clear_text();
+        time_count = ticks(0);
     }
 }
 
 void Messages::set_status(pn::string_view status, Hue hue) {
     g.status_label->set_hue(hue);
-    g.status_label->text() = StyledText::plain(
-            status, sys.fonts.tactical, GetRGBTranslateColorShade(hue, LIGHTEST));
+    g.status_label->set_text(status, sys.fonts.tactical, GetRGBTranslateColorShade(hue, LIGHTEST));
     g.status_label->set_age(kStatusLabelAge);
 }
 
@@ -407,7 +406,7 @@ void MessageLabel_Set_Special(Handle<Label> label, pn::string_view text) {
         ++it;
     }
 
-    label->text() = StyledText::plain(message, sys.fonts.tactical, kMessagesForeColor);
+    label->set_text(message, sys.fonts.tactical, kMessagesForeColor);
     label->set_keep_on_screen_anyway(true);
 
     switch (whichType.value()) {
@@ -0,0 +1,220 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <gmock/gmock.h>
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "data/base-object.hpp"
+#include "game/globals.hpp"
+#include "game/motion.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "math/fixed.hpp"
+#include "math/geometry.hpp"
+#include "math/random.hpp"
+#include "math/rotation.hpp"
+#include "math/special.hpp"
+#include "math/units.hpp"
+
+// Micro-benchmarks for the primitives on the simulation's hottest paths.  Each case runs its body
+// `kIterations` times after a short warm-up, prints the mean time per call, and records it in
+// picoseconds as the test property "ps_per_op", so `--gtest_output=json:FILE` gives results in a
+// machine-readable form.  Results feed a volatile sink so that the work is not optimized away.
+//
+// Run with --gtest_filter to measure a single primitive before and after changing it.
+
+namespace antares {
+namespace {
+
+const int64_t kIterations = 10000000;
+
+volatile int64_t sink;
+
+// The rotation table is normally loaded from data by sys_init(), which the benchmarks don't run.
+// Fill it with an equivalent table instead: ROT_0 points toward +v, and angles increase toward -h.
+class RotationTable : public testing::Environment {
+  public:
+    void SetUp() override {
+        sys.rot_table.resize(SystemGlobals::ROT_TABLE_SIZE);
+        for (int32_t i = 0; i < ROT_POS; ++i) {
+            double radians             = i * M_PI / 180.0;
+            sys.rot_table[(i * 2)]     = lround(-256.0 * sin(radians));
+            sys.rot_table[(i * 2) + 1] = lround(256.0 * cos(radians));
+        }
+    }
+    void TearDown() override { sys.rot_table.clear(); }
+};
+
+testing::Environment* const rotation_table =
+        testing::AddGlobalTestEnvironment(new RotationTable);
+
+template <typename F>
+void measure(F&& body) {
+    for (int64_t i = 0; i < (kIterations / 10); ++i) {
+        body(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < kIterations; ++i) {
+        body(i);
+    }
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    const int64_t ps   = (ns * 1000) / kIterations;
+    const auto*   info = testing::UnitTest::GetInstance()->current_test_info();
+    printf("%-32s %8lld.%03lld ns/op\n", info->name(), static_cast<long long>(ps / 1000),
+           static_cast<long long>(ps % 1000));
+    testing::Test::RecordProperty("ps_per_op", static_cast<int>(ps));
+}
+
+using MicroBench = testing::Test;
+
+TEST_F(MicroBench, FixedMultiply) {
+    Fixed x = Fixed::from_float(1.5);
+    measure([&x](int64_t i) {
+        x = (x * Fixed::from_val(257)) + Fixed::from_val(i & 0xff);
+        sink = x.val();
+    });
+}
+
+TEST_F(MicroBench, FixedDivide) {
+    Fixed x = Fixed::from_float(1000.0);
+    measure([&x](int64_t i) { sink = (x / Fixed::from_val(1 + (i & 0xffff))).val(); });
+}
+
+TEST_F(MicroBench, RandomNext) {
+    Random r{1};
+    measure([&r](int64_t i) { sink = r.next(ROT_POS); });
+}
+
+TEST_F(MicroBench, GetRotPoint) {
+    measure([](int64_t i) {
+        Fixed x, y;
+        GetRotPoint(&x, &y, i % ROT_POS);
+        sink = x.val() + y.val();
+    });
+}
+
+TEST_F(MicroBench, GetAngleFromVector) {
+    measure([](int64_t i) {
+        sink = GetAngleFromVector((i & 0x3ff) - 512, ((i >> 10) & 0x3ff) - 512);
+    });
+}
+
+TEST_F(MicroBench, RatioToAngle) {
+    measure([](int64_t i) {
+        sink = ratio_to_angle(
+                Fixed::from_val((i & 0x3ff) - 512), Fixed::from_val(((i >> 10) & 0x3ff) - 512));
+    });
+}
+
+TEST_F(MicroBench, Lsqrt) {
+    measure([](int64_t i) { sink = lsqrt(static_cast<uint32_t>(i * 2654435761u)); });
+}
+
+TEST_F(MicroBench, RectIntersects) {
+    const Rect r{-100, -100, 100, 100};
+    measure([&r](int64_t i) {
+        int32_t x = (i & 0x1ff) - 256;
+        sink      = r.intersects(Rect{x, -x, x + 50, -x + 50});
+    });
+}
+
+TEST_F(MicroBench, RectContains) {
+    const Rect r{-100, -100, 100, 100};
+    measure([&r](int64_t i) {
+        sink = r.contains(Point((i & 0x1ff) - 256, ((i >> 9) & 0x1ff) - 256));
+    });
+}
+
+// Integrates 16 lanes per op: h and v for 8 objects, as MoveSpaceObjects() batches them.
+void measure_integrate(void (*integrate)(Fixed*, const Fixed*, int32_t*, size_t)) {
+    const size_t kLanes = 16;
+    Fixed        fraction[kLanes];
+    Fixed        velocity[kLanes];
+    int32_t      position[kLanes];
+    for (size_t i = 0; i < kLanes; ++i) {
+        fraction[i] = Fixed::zero();
+        velocity[i] = Fixed::from_val(static_cast<int32_t>(37 * i) - 300);
+        position[i] = kUniversalCenter;
+    }
+    measure([&](int64_t i) {
+        integrate(fraction, velocity, position, kLanes);
+        sink = position[i % kLanes];
+    });
+}
+
+TEST_F(MicroBench, FixedIntegrate) { measure_integrate(fixed_integrate); }
+
+TEST_F(MicroBench, FixedIntegrateScalar) { measure_integrate(fixed_integrate_scalar); }
+
+class ObjectBench : public testing::Test {
+  protected:
+    void SetUp() override {
+        g.objects.reset(new SpaceObject[kMaxSpaceObject]);
+        for (auto o : SpaceObject::all()) {
+            o->active       = kObjectInUse;
+            o->attributes   = kCanTurn | kDoesBounce;
+            o->location.h   = kUniversalCenter + (o.number() * 100);
+            o->location.v   = kUniversalCenter - (o.number() * 100);
+            o->direction    = (o.number() * 7) % ROT_POS;
+            o->turnVelocity = Fixed::from_float(0.75);
+            o->thrust       = Fixed::from_float(0.5);
+            o->maxVelocity  = Fixed::from_float(4.0);
+        }
+    }
+
+    void TearDown() override { g.objects.reset(); }
+};
+
+TEST_F(ObjectBench, HandleDeref) {
+    measure([](int64_t i) { sink = Handle<SpaceObject>(i % kMaxSpaceObject)->direction; });
+}
+
+TEST_F(ObjectBench, MoveObject) {
+    measure([](int64_t i) {
+        SpaceObject* o = SpaceObject::get(i % kMaxSpaceObject);
+        move_object(o);
+        sink = o->location.h;
+    });
+}
+
+TEST_F(ObjectBench, BounceObject) {
+    measure([](int64_t i) {
+        SpaceObject* o = SpaceObject::get(i % kMaxSpaceObject);
+        bounce_object(o);
+        sink = o->location.h;
+    });
+}
+
+TEST_F(ObjectBench, TagsMatch) {
+    BaseObject o;
+    o.tags.tags.emplace("ship", true);
+    o.tags.tags.emplace("warship", true);
+    o.tags.tags.emplace("fighter", true);
+    Tags query;
+    query.tags.emplace("warship", true);
+    query.tags.emplace("cloaked", false);
+    measure([&o, &query](int64_t i) { sink = tags_match(o, query); });
+}
+
+}  // namespace
+}  // namespace antares
@@ -25,6 +25,7 @@
 #include "config/keys.hpp"
 #include "config/preferences.hpp"
 #include "drawing/color.hpp"
+#include "drawing/display-list.hpp"
 #include "drawing/pix-table.hpp"
 #include "drawing/shapes.hpp"
 #include "drawing/sprite-handling.hpp"
@@ -147,6 +148,9 @@ const int32_t kMiniAmmoTextHBuffer = 2;
 
 const int32_t kMaxShipBuffer = 40;
 
+// The minicomputer's backgrounds, underlines, highlight, and buttons.
+ANTARES_GLOBAL CachedRects gMiniScreenRects;
+
 void pad_to(pn::string& s, size_t width) {
     size_t length = pn::rune::count(s);
     if (length >= width) {
@@ -200,6 +204,7 @@ void MiniScreenInit() {
     g.mini.selectLine    = kMiniScreenNoLineSelected;
     g.mini.currentScreen = Screen::MAIN;
     g.mini.clickLine     = kMiniScreenNoLineSelected;
+    g.mini.buildCash.reset();
 
     g.mini.lines.reset(new MiniLine[kMiniScreenCharHeight]);
     g.mini.accept.reset(new MiniButton);
@@ -310,8 +315,14 @@ static void button_off_text(const Quads& quads, const MiniButton& button) {
 }
 
 static void draw_minicomputer_lines() {
-    {
-        Rects rects;
+    int32_t underlines = 0;
+    for (int32_t i = 0; i < 9; i++) {
+        underlines |= (g.mini.lines[i].underline << i);
+    }
+    if (gMiniScreenRects.update(
+                {instrument_top(), underlines, g.mini.selectLine, g.mini.accept->kind,
+                 g.mini.accept->whichButton, g.mini.cancel->kind, g.mini.cancel->whichButton})) {
+        Rects rects(&gMiniScreenRects.list);
         rects.fill(
                 Rect{Point{kMiniScreenLeft, kMiniScreenTop + instrument_top()},
                      Size{kMiniScreenWidth, kMiniScreenHeight}},
@@ -341,6 +352,7 @@ static void draw_minicomputer_lines() {
             default: break;
         }
     }
+    gMiniScreenRects.list.draw();
 
     {
         Quads           quads(sys.fonts.computer.texture);
@@ -534,16 +546,21 @@ void minicomputer_cancel() {
     minicomputer_up(g.mini.cancel.get(), NULL);
 }
 
+// Build lines are dimmed according to the admiral's cash.  They are rebuilt entirely when the
+// build-at object changes, and otherwise only need another look when the cash does.
 static void update_build_screen_lines() {
-    const auto& admiral = g.admiral;
-    MiniLine*   line    = &g.mini.lines[kBuildScreenWhereNameLine];
-    if (line->value != GetAdmiralBuildAtObject(admiral).number()) {
+    const auto& admiral  = g.admiral;
+    auto        build_at = GetAdmiralBuildAtObject(admiral);
+    MiniLine*   line     = &g.mini.lines[kBuildScreenWhereNameLine];
+    if (line->value != build_at.number()) {
         if (g.mini.selectLine != kMiniScreenNoLineSelected) {
             line              = &g.mini.lines[g.mini.selectLine];
             g.mini.selectLine = kMiniScreenNoLineSelected;
         }
         MiniComputerSetBuildStrings();
-    } else if (GetAdmiralBuildAtObject(admiral).get()) {
+    } else if (build_at.get() &&
+               !(g.mini.buildCash.has_value() && (*g.mini.buildCash == admiral->cash()))) {
+        g.mini.buildCash.emplace(admiral->cash());
         line            = g.mini.lines.get() + kBuildScreenFirstTypeLine;
         int32_t lineNum = kBuildScreenFirstTypeLine;
 
@@ -948,6 +965,7 @@ void MiniComputerDoCancel() { show_main_screen(g.admiral); }
 void MiniComputerSetBuildStrings() {
     // sets the ship type strings for the build screen
     // also sets up the values = base object num
+    g.mini.buildCash.reset();
     if (g.mini.currentScreen != Screen::BUILD) {
         return;
     }
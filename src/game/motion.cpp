@@ -30,6 +30,8 @@
 #include "game/space-object.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
+#include "math/fixed.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -148,22 +150,22 @@ void ResetMotionGlobals() {
     g.farthest           = Handle<SpaceObject>(0);
 }
 
-static void move_object(SpaceObject* o) {
+// Moves the whole part of `*fraction` out, returning it and leaving `*fraction` in [-0.5, 0.5).
+static int32_t take_whole(Fixed* fraction) {
+    const int32_t whole = fixed_round(*fraction);
+    *fraction -= Fixed::from_long(whole);
+    return whole;
+}
+
+// Turns `o` and applies its thrust.  Returns false if it does not move at all.
+static bool steer_object(SpaceObject* o) {
     if ((o->maxVelocity == Fixed::zero()) && !(o->attributes & kCanTurn)) {
-        return;
+        return false;
     }
 
     if (o->attributes & kCanTurn) {
         o->turnFraction += o->turnVelocity;
-
-        int32_t h;
-        if (o->turnFraction >= Fixed::zero()) {
-            h = more_evil_fixed_to_long(o->turnFraction + Fixed::from_float(0.5));
-        } else {
-            h = more_evil_fixed_to_long(o->turnFraction - Fixed::from_float(0.5)) + 1;
-        }
-        o->direction += h;
-        o->turnFraction -= Fixed::from_long(h);
+        o->direction += take_whole(&o->turnFraction);
 
         while (o->direction >= ROT_POS) {
             o->direction -= ROT_POS;
@@ -235,30 +237,20 @@ static void move_object(SpaceObject* o) {
         o->velocity.h += fa;
         o->velocity.v += fb;
     }
+    return true;
+}
 
+void move_object(SpaceObject* o) {
+    if (!steer_object(o)) {
+        return;
+    }
     o->motionFraction.h += o->velocity.h;
     o->motionFraction.v += o->velocity.v;
-
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
-
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
+    o->location.h -= take_whole(&o->motionFraction.h);
+    o->location.v -= take_whole(&o->motionFraction.v);
 }
 
-static void bounce_object(SpaceObject* o) {
+void bounce_object(SpaceObject* o) {
     if (!(o->attributes & kDoesBounce)) {
         if (!kThinkiverse.contains(o->location)) {
             o->active = kObjectToBeFreed;
@@ -396,11 +388,68 @@ static void update_static(SpaceObject* o, ticks unitsToDo) {
     }
 }
 
+// Everything after move_object() in one object's step of MoveSpaceObjects().
+static void finish_move(SpaceObject* o) {
+    bounce_object(o);
+    if (o->attributes & kIsSelfAnimated) {
+        animate_object(o);
+    } else if (o->attributes & kIsVector) {
+        move_vector(o);
+    }
+}
+
+// Only move_vector() reads the state of other objects.
+static bool reads_others(const SpaceObject* o) {
+    return !(o->attributes & kIsSelfAnimated) && (o->attributes & kIsVector);
+}
+
+// Moving objects whose positions are integrated together, by fixed_integrate(), with h and v in
+// alternate lanes.  Each object is steered as it is added, in list order as before, and finished
+// when the batch is flushed.  Since only a vector reads other objects, flushing before each
+// vector moves leaves every object it reads as the one-at-a-time loop would have.
+class MotionBatch {
+  public:
+    void add(SpaceObject* o) {
+        if (_count == kMaxSpaceObject) {
+            flush();
+        }
+        _objects[_count]          = o;
+        _fraction[2 * _count]     = o->motionFraction.h;
+        _fraction[2 * _count + 1] = o->motionFraction.v;
+        _velocity[2 * _count]     = o->velocity.h;
+        _velocity[2 * _count + 1] = o->velocity.v;
+        _position[2 * _count]     = o->location.h;
+        _position[2 * _count + 1] = o->location.v;
+        ++_count;
+    }
+
+    void flush() {
+        fixed_integrate(_fraction, _velocity, _position, 2 * _count);
+        for (int i = 0; i < _count; ++i) {
+            SpaceObject* o      = _objects[i];
+            o->motionFraction.h = _fraction[2 * i];
+            o->motionFraction.v = _fraction[2 * i + 1];
+            o->location.h       = _position[2 * i];
+            o->location.v       = _position[2 * i + 1];
+            finish_move(o);
+        }
+        _count = 0;
+    }
+
+  private:
+    int          _count = 0;
+    SpaceObject* _objects[kMaxSpaceObject];
+    Fixed        _fraction[2 * kMaxSpaceObject];
+    Fixed        _velocity[2 * kMaxSpaceObject];
+    int32_t      _position[2 * kMaxSpaceObject];
+};
+
 void MoveSpaceObjects(const ticks unitsToDo) {
     if (unitsToDo == ticks(0)) {
         return;
     }
 
+    MotionBatch batch;
     for (ticks jl = ticks(0); jl < unitsToDo; jl++) {
         SpaceObject* o = nullptr;
         for (Handle<SpaceObject> o_handle = g.root; (o = o_handle.get());
@@ -409,14 +458,17 @@ void MoveSpaceObjects(const ticks unitsToDo) {
                 continue;
             }
 
-            move_object(o);
-            bounce_object(o);
-            if (o->attributes & kIsSelfAnimated) {
-                animate_object(o);
-            } else if (o->attributes & kIsVector) {
-                move_vector(o);
+            if (reads_others(o)) {
+                batch.flush();
+                move_object(o);
+                finish_move(o);
+            } else if (steer_object(o)) {
+                batch.add(o);
+            } else {
+                finish_move(o);
             }
         }
+        batch.flush();
     }
 
     if (g.ship.get() && g.ship->active) {
@@ -885,8 +937,14 @@ void CollideSpaceObjects() {
 
     calc_misc(near_objects, far_objects);
     calc_bounds();
-    calc_impacts(near_objects);
-    calc_locality(far_objects);
+    {
+        ANTARES_TRACE_SCOPE("calc_impacts");
+        calc_impacts(near_objects);
+    }
+    {
+        ANTARES_TRACE_SCOPE("calc_locality");
+        calc_locality(far_objects);
+    }
     calc_visibility();
     update_last_vector_locations();
 }
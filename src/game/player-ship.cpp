@@ -230,7 +230,7 @@ static void select_object(Handle<SpaceObject> ship, bool target, Handle<Admiral>
         if (ship == g.ship) {
             label->set_age(Label::kVisibleTime);
         }
-        label->text() = StyledText::plain(
+        label->set_text(
                 name_with_hot_key_suffix(ship), sys.fonts.tactical,
                 GetRGBTranslateColorShade(hue, LIGHTEST));
     }
@@ -997,11 +997,11 @@ void PlayerShip::MessageText::start_editing() {
 void PlayerShip::MessageText::stop_editing() {
     _editing = false;
     sys.video->stop_editing(this);
-    g.send_label->text() = StyledText{};
+    g.send_label->clear_text();
 }
 
 void PlayerShip::MessageText::update(pn::string_view text, range<int> selection, range<int> mark) {
-    g.send_label->text() = StyledText::plain(
+    g.send_label->set_text(
             text, {sys.fonts.tactical, viewport().width() / 2},
             GetRGBTranslateColorShade(Hue::GREEN, LIGHTEST));
     g.send_label->text().select(selection.begin, selection.end);
@@ -1207,7 +1207,7 @@ void Update_LabelStrings_ForHotKeyChange(void) {
         if (target == g.ship) {
             g.target_label->set_age(Label::kVisibleTime);
         }
-        g.target_label->text() = StyledText::plain(
+        g.target_label->set_text(
                 name_with_hot_key_suffix(target), sys.fonts.tactical,
                 GetRGBTranslateColorShade(Hue::SKY_BLUE, LIGHTEST));
     }
@@ -1219,7 +1219,7 @@ void Update_LabelStrings_ForHotKeyChange(void) {
             g.control_label->set_age(Label::kVisibleTime);
         }
         sys.sound.select();
-        g.control_label->text() = StyledText::plain(
+        g.control_label->set_text(
                 name_with_hot_key_suffix(control), sys.fonts.tactical,
                 GetRGBTranslateColorShade(Hue::YELLOW, LIGHTEST));
     }
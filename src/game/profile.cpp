@@ -0,0 +1,184 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/profile.hpp"
+
+#include <string.h>
+#include <algorithm>
+#include <pn/output>
+#include <pn/string>
+
+namespace antares {
+
+namespace {
+
+const char* const kSubsystemNames[TickProfile::SUBSYSTEM_COUNT] = {
+        "movement", "collision", "locality",     "AI think",  "actions",
+        "conditions", "labels",  "minicomputer", "rendering",
+};
+
+// Which trace scopes count towards which subsystem.  Scopes nested within another subsystem's
+// scope also name that subsystem as `within`, so their time is not counted twice.
+struct Attribution {
+    const char*            name;
+    TickProfile::Subsystem subsystem;
+    int                    within;
+};
+
+const Attribution kAttributions[] = {
+        {"MoveSpaceObjects", TickProfile::MOVEMENT, -1},
+        {"CollideSpaceObjects", TickProfile::COLLISION, -1},
+        {"calc_locality", TickProfile::LOCALITY, TickProfile::COLLISION},
+        {"NonplayerShipThink", TickProfile::AI_THINK, -1},
+        {"AdmiralThink", TickProfile::AI_THINK, -1},
+        {"execute_action_queue", TickProfile::ACTIONS, -1},
+        {"CheckLevelConditions", TickProfile::CONDITIONS, -1},
+        {"Label::update", TickProfile::LABELS, -1},
+        {"UpdateMiniScreenLines", TickProfile::MINICOMPUTER, -1},
+        {"frame", TickProfile::RENDERING, -1},
+};
+
+const Attribution* attribution(const char* name) {
+    for (const Attribution& a : kAttributions) {
+        if (strcmp(a.name, name) == 0) {
+            return &a;
+        }
+    }
+    return nullptr;
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, int p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+// Formats nanoseconds as microseconds, with one decimal place.
+pn::string micros(int64_t ns) { return pn::format("{0}.{1}", ns / 1000, (ns / 100) % 10); }
+
+pn::string right(pn::string_view s, int width) {
+    pn::string padded;
+    for (int i = s.size(); i < width; ++i) {
+        padded += " ";
+    }
+    padded += s;
+    return padded;
+}
+
+pn::string left(pn::string_view s, int width) {
+    pn::string padded = s.copy();
+    for (int i = s.size(); i < width; ++i) {
+        padded += " ";
+    }
+    return padded;
+}
+
+}  // namespace
+
+TickProfile::TickProfile(const std::vector<trace::Event>& events) {
+    // Enclosing scopes begin no later than the scopes they enclose; break ties by putting the
+    // longer one first.
+    std::vector<trace::Event> sorted = events;
+    std::sort(sorted.begin(), sorted.end(), [](const trace::Event& x, const trace::Event& y) {
+        return (x.begin != y.begin) ? (x.begin < y.begin) : (x.end > y.end);
+    });
+
+    for (const trace::Event& e : sorted) {
+        const int64_t duration = e.end - e.begin;
+        if (strcmp(e.name, "minor tick") == 0) {
+            if (_ticks.empty() || (_ticks.back().number != e.arg)) {
+                _ticks.emplace_back();
+                Tick& t  = _ticks.back();
+                t.number = e.arg;
+                t.total  = 0;
+                std::fill(t.subsystem, t.subsystem + SUBSYSTEM_COUNT, 0);
+                std::fill(t.ran, t.ran + SUBSYSTEM_COUNT, false);
+            }
+            _ticks.back().total += duration;
+            continue;
+        } else if (_ticks.empty()) {
+            continue;  // Before the game started.
+        }
+
+        const Attribution* a = attribution(e.name);
+        if (!a) {
+            continue;
+        }
+        Tick& t = _ticks.back();
+        t.subsystem[a->subsystem] += duration;
+        t.ran[a->subsystem] = true;
+        if (a->within >= 0) {
+            t.subsystem[a->within] -= duration;
+        }
+        if (a->subsystem == RENDERING) {
+            t.total += duration;  // Frames are drawn between ticks.
+        }
+    }
+}
+
+void TickProfile::print(pn::output_view out, int worst) const {
+    out.format("{0} ticks\n\n", static_cast<int64_t>(_ticks.size()));
+    out.format(
+            "{0}{1}{2}{3}{4}\n", left("subsystem", 14), right("ticks", 8), right("p50 us", 12),
+            right("p99 us", 12), right("max us", 12));
+    for (int s = 0; s <= SUBSYSTEM_COUNT; ++s) {
+        std::vector<int64_t> times;
+        for (const Tick& t : _ticks) {
+            if (s == SUBSYSTEM_COUNT) {
+                times.push_back(t.total);
+            } else if (t.ran[s]) {
+                times.push_back(t.subsystem[s]);
+            }
+        }
+        std::sort(times.begin(), times.end());
+        out.format(
+                "{0}{1}{2}{3}{4}\n",
+                left((s == SUBSYSTEM_COUNT) ? "total" : kSubsystemNames[s], 14),
+                right(pn::format("{0}", static_cast<int64_t>(times.size())), 8),
+                right(micros(percentile(times, 50)), 12), right(micros(percentile(times, 99)), 12),
+                right(micros(percentile(times, 100)), 12));
+    }
+
+    std::vector<const Tick*> slowest;
+    for (const Tick& t : _ticks) {
+        slowest.push_back(&t);
+    }
+    std::sort(slowest.begin(), slowest.end(), [](const Tick* x, const Tick* y) {
+        return (x->total != y->total) ? (x->total > y->total) : (x->number < y->number);
+    });
+    if (slowest.size() > worst) {
+        slowest.resize(worst);
+    }
+
+    out.format("\nworst ticks:\n");
+    for (const Tick* t : slowest) {
+        out.format("  tick {0}: {1} us", t->number, micros(t->total));
+        const char* sep = " (";
+        for (int s = 0; s < SUBSYSTEM_COUNT; ++s) {
+            if (t->ran[s]) {
+                out.format("{0}{1} {2}", sep, kSubsystemNames[s], micros(t->subsystem[s]));
+                sep = ", ";
+            }
+        }
+        out.write((sep[0] == ',') ? ")\n" : "\n");
+    }
+}
+
+}  // namespace antares
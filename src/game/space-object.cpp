@@ -40,6 +40,7 @@
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/memory.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -63,8 +64,11 @@ const Hue kFriendlyColor               = Hue::GREEN;
 const Hue kHostileColor[kMaxPlayerNum] = {Hue::PINK, Hue::RED, Hue::YELLOW, Hue::ORANGE};
 const Hue kNeutralColor                = Hue::SKY_BLUE;
 
+static ANTARES_GLOBAL memory::Charge objects_charge{memory::GAME};
+
 void SpaceObjectHandlingInit() {
     g.objects.reset(new SpaceObject[kMaxSpaceObject]);
+    objects_charge.reset(kMaxSpaceObject * sizeof(SpaceObject));
     ResetAllSpaceObjects();
     reset_action_queue();
 }
@@ -49,7 +49,8 @@ inline int32_t RandomStarSpeed() { return Randomize(kStarSpeedSpread) + kMinimum
 
 }  // namespace
 
-Starfield::Starfield() : _last_clip_bottom(viewport().bottom), _warp_stars(false) {
+Starfield::Starfield()
+        : _last_clip_bottom(viewport().bottom), _spark_count(0), _warp_stars(false) {
     for (scrollStarType* star : range(_stars, _stars + kAllStarNum)) {
         star->speed = kNoStar;
     }
@@ -72,7 +73,7 @@ void Starfield::reset() {
 void Starfield::make_sparks(
         int32_t sparkNum, int32_t sparkSpeed, Fixed maxVelocity, Hue hue, Point* location) {
     maxVelocity = scale_by(maxVelocity, gAbsoluteScale);
-    if (sparkNum <= 0) {
+    if ((sparkNum <= 0) || (_spark_count == kSparkStarNum)) {
         return;
     }
 
@@ -86,6 +87,7 @@ void Starfield::make_sparks(
             spark->age                                        = kMaxSparkAge;
             spark->speed                                      = sparkSpeed;
             spark->hue                                        = hue;
+            ++_spark_count;
 
             if (--sparkNum == 0) {
                 return;
@@ -205,6 +207,9 @@ void Starfield::move(ticks by_units) {
         }
     }
 
+    if (_spark_count == 0) {
+        return;
+    }
     for (scrollStarType* star : range(_stars + kSparkStarOffset, _stars + kAllStarNum)) {
         if (star->speed == kNoStar) {
             continue;
@@ -281,6 +286,9 @@ void Starfield::draw() const {
         }
     }
 
+    if (_spark_count == 0) {
+        return;
+    }
     Points points;
     for (const scrollStarType* star : range(_stars + kSparkStarOffset, _stars + kAllStarNum)) {
         if ((star->speed != kNoStar) && (star->age > 0) && (viewport().contains(star->location))) {
@@ -323,6 +331,7 @@ void Starfield::show() {
         if (star->speed != kNoStar) {
             if (star->age <= 0) {
                 star->speed = kNoStar;
+                --_spark_count;
             }
         }
     }
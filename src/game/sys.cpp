@@ -23,6 +23,7 @@
 #include "config/gamepad.hpp"
 #include "config/keys.hpp"
 #include "data/resource.hpp"
+#include "drawing/styled-text.hpp"
 #include "drawing/text.hpp"
 #include "lang/defines.hpp"
 #include "sound/driver.hpp"
@@ -41,6 +42,7 @@ constexpr char kInstRightPictID[] = "gui/instruments/right";
 ANTARES_GLOBAL SystemGlobals sys;
 
 void sys_init() {
+    StyledText::flush_layouts();
     sys.fonts.tactical     = font("tactical");
     sys.fonts.computer     = font("computer");
     sys.fonts.button       = font("button");
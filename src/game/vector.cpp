@@ -29,6 +29,8 @@
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
 #include "lang/casts.hpp"
+#include "lang/defines.hpp"
+#include "lang/memory.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "math/units.hpp"
@@ -73,7 +75,12 @@ Vector* Vector::get(int number) {
 
 Vector::Vector() : killMe(false), active(false) {}
 
-void Vectors::init() { g.vectors.reset(new Vector[Vector::size]); }
+static ANTARES_GLOBAL memory::Charge vectors_charge{memory::GAME};
+
+void Vectors::init() {
+    g.vectors.reset(new Vector[Vector::size]);
+    vectors_charge.reset(Vector::size * sizeof(Vector));
+}
 
 void Vectors::reset() {
     for (auto vector : Vector::all()) {
@@ -0,0 +1,150 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/memory.hpp"
+
+#include <atomic>
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <pn/string>
+#include <pn/value>
+#include <utility>
+
+namespace antares {
+namespace memory {
+
+namespace {
+
+const char* const kTagNames[TAG_COUNT] = {
+        "pixmaps", "textures", "sounds", "plugin", "procyon", "game", "mapped",
+};
+
+// Zero-initialized statically, so charges made during static initialization are counted.
+std::atomic<int64_t> current[TAG_COUNT];
+std::atomic<int64_t> peak[TAG_COUNT];
+
+// Size of the header that procyon allocates ahead of each string, data, array or map.
+const int64_t kHeaderSize = 2 * sizeof(size_t);
+
+pn::string kib(int64_t bytes) { return pn::format("{0}", (bytes + 1023) / 1024); }
+
+pn::string right(pn::string_view s, int width) {
+    pn::string padded;
+    for (int i = s.size(); i < width; ++i) {
+        padded += " ";
+    }
+    padded += s;
+    return padded;
+}
+
+pn::string left(pn::string_view s, int width) {
+    pn::string padded = s.copy();
+    for (int i = s.size(); i < width; ++i) {
+        padded += " ";
+    }
+    return padded;
+}
+
+}  // namespace
+
+void charge(Tag tag, int64_t bytes) {
+    if (!bytes) {
+        return;
+    }
+    int64_t now  = current[tag].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t prev = peak[tag].load(std::memory_order_relaxed);
+    while ((now > prev) &&
+           !peak[tag].compare_exchange_weak(prev, now, std::memory_order_relaxed)) {
+    }
+}
+
+Usage usage(Tag tag) {
+    return Usage{current[tag].load(std::memory_order_relaxed),
+                 peak[tag].load(std::memory_order_relaxed)};
+}
+
+void print(pn::output_view out) {
+    out.format("{0}{1}{2}\n", left("memory", 12), right("KiB", 12), right("peak KiB", 12));
+    int64_t total = 0;
+    for (int tag = 0; tag < TAG_COUNT; ++tag) {
+        Usage u = usage(static_cast<Tag>(tag));
+        if (tag != MAPPED) {
+            total += u.current;
+        }
+        out.format(
+                "{0}{1}{2}\n", left(kTagNames[tag], 12), right(kib(u.current), 12),
+                right(kib(u.peak), 12));
+    }
+    // Tags peak at different times, so there is no meaningful total peak.
+    out.format("{0}{1}\n", left("total", 12), right(kib(total), 12));
+    out.format("(approximate; plugin is shallow; total excludes mapped files)\n");
+}
+
+int64_t size_of(pn::value_cref x) {
+    switch (x.type()) {
+        case PN_NULL:
+        case PN_BOOL:
+        case PN_INT:
+        case PN_FLOAT: return 0;
+
+        case PN_DATA: return kHeaderSize + x.as_data().size();
+        case PN_STRING: return kHeaderSize + x.as_string().size() + 1;
+
+        case PN_ARRAY: {
+            int64_t size = kHeaderSize;
+            for (pn::value_cref item : x.as_array()) {
+                size += sizeof(pn::value) + size_of(item);
+            }
+            return size;
+        }
+
+        case PN_MAP: {
+            int64_t size = kHeaderSize;
+            for (pn::key_value_cref kv : x.as_map()) {
+                size += (2 * sizeof(pn::value)) + kHeaderSize + kv.key().size() + 1 +
+                        size_of(kv.value());
+            }
+            return size;
+        }
+    }
+    return 0;
+}
+
+Charge& Charge::operator=(Charge&& other) {
+    if (this != &other) {
+        charge(_tag, -_bytes);
+        _tag         = other._tag;
+        _bytes       = other._bytes;
+        other._bytes = 0;
+    }
+    return *this;
+}
+
+void Charge::reset(int64_t bytes) {
+    charge(_tag, bytes - _bytes);
+    _bytes = bytes;
+}
+
+void Charge::swap(Charge& other) {
+    std::swap(_tag, other._tag);
+    std::swap(_bytes, other._bytes);
+}
+
+}  // namespace memory
+}  // namespace antares
@@ -0,0 +1,147 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/trace.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <pn/output>
+#include <pn/string>
+
+namespace antares {
+namespace trace {
+
+std::atomic<bool> recording{false};
+
+namespace {
+
+// Each thread appends to its own chain of chunks, so recording takes no lock.  Only the owning
+// thread writes to a chunk; it publishes each event by a release store of `size`, and links a
+// new chunk only once the previous one is full.  Readers follow the same chain with acquire
+// loads, and so see only complete events.
+const int kChunkSize = 4096;
+
+struct Chunk {
+    Event               events[kChunkSize];
+    std::atomic<int>    size{0};
+    std::atomic<Chunk*> next{nullptr};
+};
+
+struct Buffer {
+    int                  thread;
+    Chunk                head;
+    Chunk*               tail = &head;  // touched only by the owning thread
+    std::atomic<Buffer*> next{nullptr};
+};
+
+// Buffers are never freed, so events from threads that have exited remain readable.
+std::mutex           buffers_mutex;
+std::atomic<Buffer*> buffers{nullptr};
+int                  thread_count = 0;
+thread_local Buffer* this_thread_buffer = nullptr;
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+Buffer* new_buffer() {
+    Buffer*                     b = new Buffer;
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    b->thread = ++thread_count;
+    b->next.store(buffers.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    buffers.store(b, std::memory_order_release);
+    return b;
+}
+
+void write_escaped(pn::output_view out, const char* s) {
+    for (; *s; ++s) {
+        if ((*s == '"') || (*s == '\\')) {
+            out.write("\\");
+        }
+        out.write(pn::string_view{s, 1});
+    }
+}
+
+// Writes nanoseconds as microseconds, the unit of the trace-event format, keeping all digits.
+void write_micros(pn::output_view out, int64_t ns) {
+    int64_t frac = ns % 1000;
+    out.format("{0}.{1}{2}{3}", ns / 1000, frac / 100, (frac / 10) % 10, frac % 10);
+}
+
+}  // namespace
+
+void start() { recording.store(true, std::memory_order_relaxed); }
+void stop() { recording.store(false, std::memory_order_relaxed); }
+
+std::vector<Event> events() {
+    std::vector<Event> result;
+    for (Buffer* b = buffers.load(std::memory_order_acquire); b;
+         b         = b->next.load(std::memory_order_relaxed)) {
+        for (const Chunk* c = &b->head; c; c = c->next.load(std::memory_order_acquire)) {
+            int size = c->size.load(std::memory_order_acquire);
+            result.insert(result.end(), c->events, c->events + size);
+        }
+    }
+    return result;
+}
+
+void write(pn::output_view out) {
+    out.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (const Event& e : events()) {
+        out.write(first ? "\n" : ",\n");
+        first = false;
+        out.write("{\"name\":\"");
+        write_escaped(out, e.name);
+        out.format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{0},\"ts\":", e.thread);
+        write_micros(out, e.begin);
+        out.write(",\"dur\":");
+        write_micros(out, e.end - e.begin);
+        if (e.arg != kNoArg) {
+            out.write(",\"args\":{\"n\":");
+            out.format("{0}", e.arg);
+            out.write("}");
+        }
+        out.write("}");
+    }
+    out.write("\n]}\n");
+}
+
+int64_t Scope::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - epoch)
+            .count();
+}
+
+void Scope::record(const char* name, int64_t begin, int64_t end, int64_t arg) {
+    Buffer* b = this_thread_buffer;
+    if (!b) {
+        b = this_thread_buffer = new_buffer();
+    }
+    Chunk* c    = b->tail;
+    int    size = c->size.load(std::memory_order_relaxed);
+    if (size == kChunkSize) {
+        Chunk* next = new Chunk;
+        c->next.store(next, std::memory_order_release);
+        b->tail = c = next;
+        size        = 0;
+    }
+    c->events[size] = Event{name, begin, end, arg, b->thread};
+    c->size.store(size + 1, std::memory_order_release);
+}
+
+}  // namespace trace
+}  // namespace antares
@@ -18,10 +18,17 @@
 
 #include "math/fixed.hpp"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <cmath>
 #include <pn/output>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace antares {
 
 // From scripts/generate-fixed-table.py.
@@ -63,4 +70,46 @@ pn::string stringify(Fixed fixed) {
     return pn::format("{}{}{}", prefix, integral, kFractions[value]);
 }
 
+static_assert(sizeof(Fixed) == sizeof(int32_t), "vector lanes must be Fixed values");
+
+// Arithmetic is done on uint32_t here, so that sums which overflow wrap as they do in the vector
+// registers, rather than being undefined.  The final conversion back is modular, like the shifts.
+void fixed_integrate_scalar(
+        Fixed* fraction, const Fixed* velocity, int32_t* position, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t f     = uint32_t(fraction[i].val()) + uint32_t(velocity[i].val());
+        const int32_t  whole = int32_t(f + 128) >> 8;
+        fraction[i]          = Fixed::from_val(int32_t(f - (uint32_t(whole) << 8)));
+        position[i]          = int32_t(uint32_t(position[i]) - uint32_t(whole));
+    }
+}
+
+void fixed_integrate(Fixed* fraction, const Fixed* velocity, int32_t* position, size_t count) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i half = _mm_set1_epi32(128);
+    for (; (i + 4) <= count; i += 4) {
+        __m128i* fp = reinterpret_cast<__m128i*>(fraction + i);
+        __m128i* pp = reinterpret_cast<__m128i*>(position + i);
+        __m128i  f  = _mm_add_epi32(
+                _mm_loadu_si128(fp),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(velocity + i)));
+        __m128i whole = _mm_srai_epi32(_mm_add_epi32(f, half), 8);
+        _mm_storeu_si128(fp, _mm_sub_epi32(f, _mm_slli_epi32(whole, 8)));
+        _mm_storeu_si128(pp, _mm_sub_epi32(_mm_loadu_si128(pp), whole));
+    }
+#elif defined(__ARM_NEON)
+    const int32x4_t half = vdupq_n_s32(128);
+    for (; (i + 4) <= count; i += 4) {
+        int32_t*  fp = reinterpret_cast<int32_t*>(fraction + i);
+        int32x4_t f  = vaddq_s32(
+                vld1q_s32(fp), vld1q_s32(reinterpret_cast<const int32_t*>(velocity + i)));
+        int32x4_t whole = vshrq_n_s32(vaddq_s32(f, half), 8);
+        vst1q_s32(fp, vsubq_s32(f, vshlq_n_s32(whole, 8)));
+        vst1q_s32(position + i, vsubq_s32(vld1q_s32(position + i), whole));
+    }
+#endif
+    fixed_integrate_scalar(fraction + i, velocity + i, position + i, count - i);
+}
+
 }  // namespace antares
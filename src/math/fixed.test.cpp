@@ -19,6 +19,7 @@
 #include "math/fixed.hpp"
 
 #include <gmock/gmock.h>
+#include <vector>
 
 using testing::Eq;
 using testing::Ge;
@@ -157,5 +158,85 @@ TEST_F(FixedTest, Math) {
     EXPECT_THAT(Fixed::from_long(2) << 1, Eq(Fixed::from_long(4)));
 }
 
+TEST_F(FixedTest, Round) {
+    EXPECT_THAT(fixed_round(Fixed::from_float(0.0)), Eq(0));
+    EXPECT_THAT(fixed_round(Fixed::from_float(0.25)), Eq(0));
+    EXPECT_THAT(fixed_round(Fixed::from_float(0.5)), Eq(1));
+    EXPECT_THAT(fixed_round(Fixed::from_float(1.75)), Eq(2));
+    EXPECT_THAT(fixed_round(Fixed::from_float(-0.25)), Eq(0));
+    EXPECT_THAT(fixed_round(Fixed::from_float(-0.5)), Eq(0));
+    EXPECT_THAT(fixed_round(Fixed::from_float(-0.75)), Eq(-1));
+    EXPECT_THAT(fixed_round(Fixed::from_float(-1.5)), Eq(-1));
+
+    // Same as the sign-dependent rounding that motion used to do.
+    for (int32_t i = -4096; i <= 4096; ++i) {
+        const Fixed   f = Fixed::from_val(i);
+        const int32_t expected =
+                (f >= Fixed::zero())
+                        ? more_evil_fixed_to_long(f + Fixed::from_float(0.5))
+                        : more_evil_fixed_to_long(f - Fixed::from_float(0.5)) + 1;
+        EXPECT_THAT(fixed_round(f), Eq(expected)) << i;
+    }
+}
+
+// Lanes chosen to cover rounding on either side of each half, both signs, and sums that wrap.
+// The count is not a multiple of four, so that the vector path's scalar tail is also covered.
+std::vector<int32_t> integrate_lanes() {
+    std::vector<int32_t> lanes = {
+            0,    1,    127,  128,  129,   255,   256,   383,  384,
+            -1,   -127, -128, -129, -255,  -256,  -383,  -384, 0x7fffff80,
+            -0x7fffff80 - 1,
+    };
+    uint32_t x = 1;
+    while (lanes.size() < 1027) {
+        x = (x * 1103515245) + 12345;
+        lanes.push_back(static_cast<int32_t>(x));
+    }
+    return lanes;
+}
+
+TEST_F(FixedTest, Integrate) {
+    const std::vector<int32_t> lanes = integrate_lanes();
+    const size_t               count = lanes.size();
+
+    std::vector<Fixed>   fraction, velocity, scalar_fraction;
+    std::vector<int32_t> position, scalar_position;
+    for (size_t i = 0; i < count; ++i) {
+        fraction.push_back(Fixed::from_val(lanes[i] >> 9));
+        velocity.push_back(Fixed::from_val(lanes[(i * 7) % count] >> ((i % 3) ? 12 : 0)));
+        position.push_back(lanes[(i * 13) % count]);
+    }
+    scalar_fraction = fraction;
+    scalar_position = position;
+
+    for (int step = 0; step < 3; ++step) {
+        fixed_integrate(fraction.data(), velocity.data(), position.data(), count);
+        fixed_integrate_scalar(
+                scalar_fraction.data(), velocity.data(), scalar_position.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_THAT(fraction[i], Eq(scalar_fraction[i])) << step << ", " << i;
+            EXPECT_THAT(position[i], Eq(scalar_position[i])) << step << ", " << i;
+        }
+    }
+}
+
+// Where nothing wraps, the reference matches stepping with Fixed, as move_object() does.
+TEST_F(FixedTest, IntegrateScalar) {
+    for (int32_t f = -512; f <= 512; f += 3) {
+        for (int32_t v = -4096; v <= 4096; v += 37) {
+            Fixed   fraction = Fixed::from_val(f);
+            Fixed   velocity = Fixed::from_val(v);
+            int32_t position = 1000;
+            fixed_integrate_scalar(&fraction, &velocity, &position, 1);
+
+            Fixed         expected_fraction = Fixed::from_val(f) + velocity;
+            const int32_t whole             = fixed_round(expected_fraction);
+            expected_fraction -= Fixed::from_long(whole);
+            EXPECT_THAT(fraction, Eq(expected_fraction)) << f << ", " << v;
+            EXPECT_THAT(position, Eq(1000 - whole)) << f << ", " << v;
+        }
+    }
+}
+
 }  // namespace
 }  // namespace antares
@@ -60,7 +60,7 @@ class NullSound : public Sound {
   public:
     NullSound() {}
 
-    virtual void play(uint8_t volume) {}
+    virtual void play(uint8_t volume, int8_t pan) {}
     virtual void loop(uint8_t volume) {}
 };
 
@@ -118,7 +118,10 @@ class LogSoundDriver::LogSound : public Sound {
     LogSound(const LogSoundDriver& driver, pn::string_view kind, pn::string_view path)
             : _driver(driver), _kind(kind.copy()), _path(path.copy()) {}
 
-    virtual void play(uint8_t volume) { _driver._active_channel->play(_kind, _path, volume); }
+    // Pan is left out of the log, which records which sounds play, and how loudly.
+    virtual void play(uint8_t volume, int8_t pan) {
+        _driver._active_channel->play(_kind, _path, volume);
+    }
     virtual void loop(uint8_t volume) { _driver._active_channel->loop(_kind, _path, volume); }
 
   private:
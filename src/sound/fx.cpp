@@ -18,6 +18,8 @@
 
 #include "sound/fx.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <pn/output>
 
 #include "config/preferences.hpp"
@@ -84,18 +86,54 @@ enum {
     kMustPlaySound        = 5
 };
 
+// A sound is never played on more than this many channels at once; any more instances replace an
+// existing one that is no louder, or are dropped.  This keeps a single weapon fired by many ships
+// from crowding out every other sound.
+static const int kMaxSoundInstances = 2;
+
+// Requests for the same sound within this long are coalesced: only the loudest is played.
+static const ticks kCoalesceTime = ticks(1);
+
+// Within this distance, a sound plays at full volume; beyond it, it fades out over 1920 more.
+static const int32_t kFullVolumeDistance = 480;
+
+// Pan for a sound directly to the left or right; see Sound::play().
+static const int32_t kMaxPan = 127;
+
+// Beyond this distance, a sound is culled without computing its exact distance.  lsqrt() rounds,
+// so this is one more than the largest audible distance, 2400, squared.
+static const int32_t kInaudibleDistanceSquared = 2401 * 2401;
+
 struct SoundFX::smartSoundChannel {
     pn::string                    whichSound;
+    wall_time                     started;
     wall_time                     reserved_until;
     int16_t                       soundVolume;
     uint8_t                       soundPriority;
     std::unique_ptr<SoundChannel> channelPtr;
 };
 
-struct SoundFX::smartSoundHandle {
-    pn::string             id;
-    std::unique_ptr<Sound> soundHandle;
-};
+// see if a channel started the same sound just now, at the same or higher volume
+bool SoundFX::coalesced(pn::string_view id, uint8_t amplitude) {
+    for (int i = 0; i < kMaxChannelNum; ++i) {
+        if ((channels[i].whichSound == id) && (channels[i].soundVolume >= amplitude) &&
+            ((now() - channels[i].started) < kCoalesceTime)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// count the channels still reserved for the same sound
+int SoundFX::instances(pn::string_view id) {
+    int count = 0;
+    for (int i = 0; i < kMaxChannelNum; ++i) {
+        if ((channels[i].whichSound == id) && (channels[i].reserved_until > now())) {
+            ++count;
+        }
+    }
+    return count;
+}
 
 // see if there's a channel with the same sound at same or lower volume
 bool SoundFX::same_sound_channel(
@@ -148,39 +186,47 @@ bool SoundFX::oldest_available_channel(int& channel) {
     return result;
 }
 
+// Picks a channel for the sound, or returns false if it should be dropped.  Has no side effects,
+// and a sound dropped at some volume is also dropped at any lower volume, so play_at() can use it
+// to cull sounds before working out how loud they are.
 bool SoundFX::best_channel(
-        int& channel, pn::string_view sound_id, uint8_t amplitude, usecs persistence,
-        uint8_t priority) {
+        int& channel, pn::string_view sound_id, uint8_t amplitude, uint8_t priority) {
+    if (coalesced(sound_id, amplitude)) {
+        return false;
+    } else if (instances(sound_id) >= kMaxSoundInstances) {
+        return same_sound_channel(channel, sound_id, amplitude, priority);
+    }
     return same_sound_channel(channel, sound_id, amplitude, priority) ||
            quieter_channel(channel, amplitude) || lower_priority_channel(channel, priority) ||
            oldest_available_channel(channel);
 }
 
 void SoundFX::play(pn::string_view id, uint8_t amplitude, usecs persistence, uint8_t priority) {
+    start(id, amplitude, persistence, priority, 0);
+}
+
+void SoundFX::start(
+        pn::string_view id, uint8_t amplitude, usecs persistence, uint8_t priority, int8_t pan) {
     int32_t whichChannel = -1;
     // TODO(sfiera): don't play sound at all if the game is muted.
     if (amplitude > 0) {
-        if (!best_channel(whichChannel, id, amplitude, persistence, priority)) {
+        if (!best_channel(whichChannel, id, amplitude, priority)) {
             return;
         }
 
-        int whichSound = 0;
-        for (; whichSound < sounds.size(); ++whichSound) {
-            if (sounds[whichSound].id == id) {
-                break;
-            }
-        }
-        if (whichSound == sounds.size()) {
+        auto it = sounds.find(id.copy());
+        if (it == sounds.end()) {
             return;
         }
 
         channels[whichChannel].whichSound     = id.copy();
+        channels[whichChannel].started        = now();
         channels[whichChannel].reserved_until = now() + persistence;
         channels[whichChannel].soundPriority  = priority;
         channels[whichChannel].soundVolume    = amplitude;
 
         channels[whichChannel].channelPtr->activate();
-        sounds[whichSound].soundHandle->play(amplitude);
+        it->second->play(amplitude, pan);
     }
 }
 
@@ -190,6 +236,7 @@ SoundFX::~SoundFX() {}
 void SoundFX::init() {
     channels.resize(kMaxChannelNum);
     for (int i = 0; i < kMaxChannelNum; i++) {
+        channels[i].started        = wall_time();
         channels[i].reserved_until = wall_time();
         channels[i].soundPriority  = kNoSound;
         channels[i].soundVolume    = 0;
@@ -201,31 +248,28 @@ void SoundFX::init() {
 }
 
 void SoundFX::shutdown() {
-    sounds.resize(0);
+    sounds.clear();
     channels.resize(0);
 }
 
 void SoundFX::reset() {
-    sounds.resize(kMinVolatileSound);
-    for (int i = 0; i < kMinVolatileSound; ++i) {
-        if (!sounds[i].soundHandle.get()) {
-            auto id               = kFixedSounds[i];
-            sounds[i].id          = id.copy();
-            sounds[i].soundHandle = sys.audio->open_sound(id);
+    for (auto it = sounds.begin(); it != sounds.end();) {
+        if (std::find(std::begin(kFixedSounds), std::end(kFixedSounds), it->first) ==
+            std::end(kFixedSounds)) {
+            it = sounds.erase(it);
+        } else {
+            ++it;
         }
     }
+    for (pn::string_view id : kFixedSounds) {
+        load(id);
+    }
 }
 
 void SoundFX::load(pn::string_view id) {
-    int whichSound = 0;
-    while ((whichSound < sounds.size()) && (sounds[whichSound].id != id)) {
-        whichSound++;
-    }
-
-    if (whichSound == sounds.size()) {
-        sounds.emplace_back();
-        sounds.back().id          = id.copy();
-        sounds.back().soundHandle = sys.audio->open_sound(id);
+    std::unique_ptr<Sound>& sound = sounds[id.copy()];
+    if (!sound) {
+        sound = sys.audio->open_sound(id);
     }
 }
 
@@ -265,15 +309,25 @@ void SoundFX::play_at(
         return;
     }
 
+    // Distance only ever makes a sound quieter, so if it couldn't get a channel at full volume,
+    // don't bother working out how far away it is.
+    int channel;
+    if ((volume <= 0) ||
+        !best_channel(channel, id, std::min<int32_t>(volume, kMaxSoundVolume), priority)) {
+        return;
+    }
+
+    Point center;
+    if (g.ship.get() && g.ship->active) {
+        center = g.ship->location;
+    } else {
+        center = scaled_screen.bounds.center();
+    }
+    const int32_t dx = origin->location.h - center.h;
+
     int32_t distance = origin->distanceFromPlayer;
     if (distance == 0) {
-        Point center;
-        if (g.ship.get() && g.ship->active) {
-            center = g.ship->location;
-        } else {
-            center = scaled_screen.bounds.center();
-        }
-        int32_t xdiff = abs(center.h - origin->location.h);
+        int32_t xdiff = abs(dx);
         int32_t ydiff = abs(center.v - origin->location.v);
         if ((xdiff < kMaximumRelevantDistance) && (ydiff < kMaximumRelevantDistance)) {
             distance = ydiff * ydiff + xdiff * xdiff;
@@ -281,16 +335,26 @@ void SoundFX::play_at(
             distance = kMaximumRelevantDistanceSquared;
         }
     }
+    if (distance >= kInaudibleDistanceSquared) {
+        return;
+    }
 
     distance = lsqrt(distance);
     if (distance > 2400) {
         return;
-    } else if (distance > 480) {
-        distance -= 480;
+    }
+
+    // Pan by the sine of the sound's bearing from the player, but nearer the center for sounds
+    // within kFullVolumeDistance: those are at full volume, and all but on top of the player.
+    const int32_t scale = std::max(distance, kFullVolumeDistance);
+    const int32_t pan   = (kMaxPan * std::max(-scale, std::min(scale, dx))) / scale;
+
+    if (distance > kFullVolumeDistance) {
+        distance -= kFullVolumeDistance;
         volume = ((1920 - distance) * volume) / 1920;
     }
     if (volume > 0) {
-        sys.sound.play(id, volume, persistence, priority);
+        start(id, volume, persistence, priority, pan);
     }
 }
 
@@ -0,0 +1,322 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "sound/mix-driver.hpp"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "data/audio.hpp"
+#include "data/resource.hpp"
+#include "data/sound-bank.hpp"
+#include "game/time.hpp"
+
+using std::unique_ptr;
+
+namespace antares {
+
+namespace {
+
+const int      kChunkFrames  = 1024;  // frames mixed at a time
+const int      kStreamFrames = 4096;  // frames of music decoded at a time
+const uint64_t kOne          = uint64_t{1} << 32;
+
+// Matches OpenAlSoundDriver, where a channel's volume 255 and global volume 8 are unity gain.
+const int kUnityVolume = 255 * 8;
+
+void append_u16(pn::data& out, uint16_t x) {
+    uint8_t bytes[2] = {uint8_t(x), uint8_t(x >> 8)};
+    out += pn::data_view{bytes, 2};
+}
+
+void append_u32(pn::data& out, uint32_t x) {
+    uint8_t bytes[4] = {uint8_t(x), uint8_t(x >> 8), uint8_t(x >> 16), uint8_t(x >> 24)};
+    out += pn::data_view{bytes, 4};
+}
+
+// A 44-byte WAV header.  The sizes are patched in by close().
+pn::data wav_header(uint32_t data_size) {
+    pn::data out;
+    out += pn::data_view{reinterpret_cast<const uint8_t*>("RIFF"), 4};
+    append_u32(out, 36 + data_size);
+    out += pn::data_view{reinterpret_cast<const uint8_t*>("WAVEfmt "), 8};
+    append_u32(out, 16);
+    append_u16(out, 1);  // LPCM
+    append_u16(out, 2);
+    append_u32(out, MixSoundDriver::kSampleRate);
+    append_u32(out, MixSoundDriver::kSampleRate * 2 * sizeof(int16_t));
+    append_u16(out, 2 * sizeof(int16_t));
+    append_u16(out, 16);
+    out += pn::data_view{reinterpret_cast<const uint8_t*>("data"), 4};
+    append_u32(out, data_size);
+    return out;
+}
+
+// Balance: centered, both sides play at full gain; panned, the far side is attenuated linearly,
+// down to silence at -127 or 127.  Gains are 16.16 fixed point.
+int64_t pan_gain(int8_t pan, int side) {
+    const int p   = std::max<int>(-127, std::min<int>(127, pan));
+    const int far = (side == 0) ? std::max(p, 0) : std::max(-p, 0);
+    return ((127 - far) * int64_t{65536}) / 127;
+}
+
+int64_t frame_at(wall_time time) {
+    return (std::chrono::duration_cast<usecs>(time.time_since_epoch()).count() *
+            MixSoundDriver::kSampleRate) /
+           1000000;
+}
+
+}  // namespace
+
+// A sound or song playing on a channel.  Resamples its source to kSampleRate by linear
+// interpolation between the source frames `_cur` and `_next`.
+struct MixSoundDriver::Voice {
+    Voice(std::shared_ptr<const CachedSound> sound, unique_ptr<AudioStream> stream, int channels,
+          int frequency, bool looping, uint8_t volume, int8_t pan)
+            : _sound(std::move(sound)),
+              _stream(std::move(stream)),
+              _channels(std::max(channels, 1)),
+              _step((uint64_t(frequency) << 32) / kSampleRate),
+              _looping(looping),
+              _volume(volume),
+              _pan{pan_gain(pan, 0), pan_gain(pan, 1)} {
+        _done = !pull(_cur) || !pull(_next);
+    }
+
+    // Adds `count` frames to `out`.  Returns false once the voice has finished.
+    bool mix(int32_t* out, int count, int global_volume) {
+        const int64_t volume  = (int64_t{_volume} * global_volume * 65536) / kUnityVolume;
+        const int64_t gain[2] = {(volume * _pan[0]) >> 16, (volume * _pan[1]) >> 16};
+        for (int i = 0; (i < count) && !_done; ++i) {
+            const int64_t t = _phase >> 16;
+            for (int c = 0; c < 2; ++c) {
+                const int64_t s = _cur[c] + (((_next[c] - _cur[c]) * t) >> 16);
+                out[(2 * i) + c] += (s * gain[c]) >> 16;
+            }
+            for (_phase += _step; _phase >= kOne; _phase -= kOne) {
+                std::copy(_next, _next + 2, _cur);
+                if (!pull(_next)) {
+                    _done = true;
+                    break;
+                }
+            }
+        }
+        return !_done;
+    }
+
+  private:
+    // Reads the next source frame into `frame`, taking mono as both left and right.
+    bool pull(int32_t* frame) {
+        if ((_offset + _channels) > _size) {
+            if (!refill()) {
+                return false;
+            }
+        }
+        const int16_t* samples = _sound ? reinterpret_cast<const int16_t*>(_sound->data().data())
+                                        : _buffer.data();
+        frame[0] = samples[_offset];
+        frame[1] = samples[_offset + _channels - 1];
+        _offset += _channels;
+        return true;
+    }
+
+    bool refill() {
+        if (_sound) {
+            if ((_size > 0) && !_looping) {
+                return false;
+            }
+            _size = (_sound->data().size() / sizeof(int16_t) / _channels) * _channels;
+        } else {
+            _buffer.resize(kStreamFrames * _channels);
+            size_t bytes = _stream->read(_buffer.data(), _buffer.size() * sizeof(int16_t));
+            if ((bytes == 0) && _looping) {
+                _stream->rewind();
+                bytes = _stream->read(_buffer.data(), _buffer.size() * sizeof(int16_t));
+            }
+            _size = (bytes / sizeof(int16_t) / _channels) * _channels;
+        }
+        _offset = 0;
+        return _size > 0;
+    }
+
+    const std::shared_ptr<const CachedSound> _sound;
+    const unique_ptr<AudioStream>            _stream;
+    std::vector<int16_t>                     _buffer;  // decoded from _stream
+    size_t                                   _size   = 0;  // samples in source
+    size_t                                   _offset = 0;  // next sample in source
+    const int                                _channels;
+    const uint64_t                           _step;  // source frames per output frame, 32.32
+    uint64_t                                 _phase = 0;
+    const bool                               _looping;
+    const uint8_t                            _volume;
+    const int64_t                            _pan[2];  // gain of left and right, 16.16
+    bool                                     _done;
+    int32_t                                  _cur[2];
+    int32_t                                  _next[2];
+};
+
+class MixSoundDriver::MixChannel : public SoundChannel {
+  public:
+    MixChannel(MixSoundDriver& driver) : _id(driver._voices.size()), _driver(driver) {
+        driver._voices.emplace_back();
+    }
+
+    void activate() override { _driver._active_channel = _id; }
+
+    void quiet() override {
+        _driver.advance(now());
+        _driver._voices[_id].reset();
+    }
+
+  private:
+    const int       _id;
+    MixSoundDriver& _driver;
+};
+
+class MixSoundDriver::MixSound : public Sound {
+  public:
+    MixSound(MixSoundDriver& driver, pn::string_view path)
+            : _driver(driver), _sound(new CachedSound(CachedSound::load(path))) {}
+
+    virtual void play(uint8_t volume, int8_t pan) { start(false, volume, pan); }
+    virtual void loop(uint8_t volume) { start(true, volume, 0); }
+
+  private:
+    void start(bool looping, uint8_t volume, int8_t pan) {
+        _driver.start(unique_ptr<Voice>(new Voice(
+                _sound, nullptr, _sound->channels(), _sound->frequency(), looping, volume, pan)));
+    }
+
+    MixSoundDriver&                          _driver;
+    const std::shared_ptr<const CachedSound> _sound;
+};
+
+class MixSoundDriver::MixMusic : public Sound {
+  public:
+    MixMusic(MixSoundDriver& driver, pn::string_view path)
+            : _driver(driver), _path(path.copy()), _stream(Resource::music_stream(_path)) {}
+
+    virtual void play(uint8_t volume, int8_t pan) { start(false, volume); }
+    virtual void loop(uint8_t volume) { start(true, volume); }
+
+  private:
+    // As with OpenAlMusic, the first start takes the stream opened by open_music().
+    void start(bool looping, uint8_t volume) {
+        unique_ptr<AudioStream> stream = _stream ? std::move(_stream)
+                                                 : Resource::music_stream(_path);
+        const int channels  = stream->channels();
+        const int frequency = stream->frequency();
+        _driver.start(unique_ptr<Voice>(
+                new Voice(nullptr, std::move(stream), channels, frequency, looping, volume, 0)));
+    }
+
+    MixSoundDriver&         _driver;
+    const pn::string        _path;
+    unique_ptr<AudioStream> _stream;
+};
+
+MixSoundDriver::MixSoundDriver(sfz::optional<pn::string_view> path)
+        : _frames(0),
+          _global_volume(8),
+          _active_channel(-1),
+          _mix_time(std::chrono::nanoseconds::zero()) {
+    if (path.has_value()) {
+        _wav_path = path->copy();
+        _wav.reset(new pn::output{_wav_path, pn::binary});
+        _wav->write(wav_header(0)).check();
+    }
+}
+
+MixSoundDriver::~MixSoundDriver() {
+    try {
+        close();
+    } catch (...) {
+        // close() reports errors to owners that call it; here, there is no one to tell.
+    }
+}
+
+void MixSoundDriver::close() {
+    if (!_wav) {
+        return;
+    }
+    std::unique_ptr<pn::output> wav = std::move(_wav);
+    if (fseek(wav->c_obj(), 0, SEEK_SET) != 0) {
+        throw std::runtime_error(pn::format("{0}: couldn't seek", _wav_path).c_str());
+    }
+    wav->write(wav_header(_frames * 2 * sizeof(int16_t))).check();
+}
+
+unique_ptr<SoundChannel> MixSoundDriver::open_channel() {
+    return unique_ptr<SoundChannel>(new MixChannel(*this));
+}
+
+unique_ptr<Sound> MixSoundDriver::open_sound(pn::string_view path) {
+    return unique_ptr<Sound>(new MixSound(*this, path));
+}
+
+unique_ptr<Sound> MixSoundDriver::open_music(pn::string_view path) {
+    return unique_ptr<Sound>(new MixMusic(*this, path));
+}
+
+void MixSoundDriver::set_global_volume(uint8_t volume) {
+    advance(now());
+    _global_volume = volume;
+}
+
+void MixSoundDriver::advance(wall_time time) {
+    const int64_t until = frame_at(time);
+    if (until > _frames) {
+        mix(until - _frames);
+    }
+}
+
+void MixSoundDriver::start(unique_ptr<Voice> voice) {
+    if (_active_channel >= 0) {
+        advance(now());
+        _voices[_active_channel] = std::move(voice);
+    }
+}
+
+void MixSoundDriver::mix(int64_t count) {
+    const auto start = std::chrono::steady_clock::now();
+    while (count > 0) {
+        const int n = std::min<int64_t>(count, kChunkFrames);
+        _accum.assign(2 * n, 0);
+        for (unique_ptr<Voice>& voice : _voices) {
+            if (voice && !voice->mix(_accum.data(), n, _global_volume)) {
+                voice.reset();
+            }
+        }
+        _out.resize(2 * n);
+        for (int i = 0; i < (2 * n); ++i) {
+            _out[i] = std::min<int32_t>(std::max<int32_t>(_accum[i], INT16_MIN), INT16_MAX);
+        }
+        if (_wav) {  // WAV is little-endian, as is every platform Antares runs on
+            _wav->write(pn::data_view{reinterpret_cast<const uint8_t*>(_out.data()),
+                                      static_cast<int>(_out.size() * sizeof(int16_t))})
+                    .check();
+        }
+        _frames += n;
+        count -= n;
+    }
+    _mix_time += std::chrono::steady_clock::now() - start;
+}
+
+}  // namespace antares
@@ -18,10 +18,20 @@
 
 #include "sound/openal-driver.hpp"
 
+#include <math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <pn/output>
+#include <thread>
+#include <vector>
 
 #include "data/audio.hpp"
 #include "data/resource.hpp"
+#include "data/sound-bank.hpp"
+#include "lang/memory.hpp"
 
 using std::unique_ptr;
 
@@ -49,31 +59,200 @@ void check_al_error(pn::string_view method) {
     }
 }
 
+// Music is queued on its source in this many buffers of kStreamBufferBytes each, about 1.5s in
+// all at 44.1kHz stereo.  A buffer is refilled as soon as it has played, so playback survives a
+// stall of the refilling thread for up to the length of the rest of the queue.
+const int     kStreamBuffers     = 4;
+const size_t  kStreamBufferBytes = 65536;
+const int64_t kStreamPollMs      = 20;
+
 }  // namespace
 
+// Plays an AudioStream on a source, decoding it on a worker thread into a small ring of buffers,
+// so that playback begins at once and memory use does not grow with the length of the song.
+//
+// Only the worker touches the source's queue while it runs.  It takes the driver's AL mutex for
+// AL calls, but decodes without it, and checks for a stop request before each buffer it decodes.
+// Once a stream that does not loop has been decoded to its end, the worker exits, and the source
+// plays out what is queued.  Destroying the Streamer stops the worker, then the source, and frees
+// the buffers.
+class OpenAlSoundDriver::Streamer {
+  public:
+    Streamer(std::mutex& al_mutex, ALuint source, std::unique_ptr<AudioStream> stream, bool looping)
+            : _al_mutex(al_mutex),
+              _source(source),
+              _stream(std::move(stream)),
+              _looping(looping),
+              _format((_stream->channels() == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16),
+              _chunk(kStreamBufferBytes),
+              _charge(memory::SOUNDS, kStreamBuffers * kStreamBufferBytes) {
+        {
+            std::lock_guard<std::mutex> al(_al_mutex);
+            alGenBuffers(kStreamBuffers, _buffers);
+            check_al_error("alGenBuffers");
+        }
+
+        // Fill the first buffers here, so the song starts without waiting for the worker.
+        int queued = 0;
+        while (queued < kStreamBuffers) {
+            size_t size = decode();
+            if (size == 0) {
+                break;
+            }
+            std::lock_guard<std::mutex> al(_al_mutex);
+            alBufferData(_buffers[queued], _format, _chunk.data(), size, _stream->frequency());
+            check_al_error("alBufferData");
+            ++queued;
+        }
+        if (queued > 0) {
+            std::lock_guard<std::mutex> al(_al_mutex);
+            alSourceQueueBuffers(_source, queued, _buffers);
+            check_al_error("alSourceQueueBuffers");
+            alSourcePlay(_source);
+            check_al_error("alSourcePlay");
+        }
+        _thread = std::thread([this] { run(); });
+    }
+
+    ~Streamer() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+
+        std::lock_guard<std::mutex> al(_al_mutex);
+        alSourceStop(_source);
+        alSourcei(_source, AL_BUFFER, 0);  // unqueues all buffers
+        alDeleteBuffers(kStreamBuffers, _buffers);
+        alGetError();  // discard.
+    }
+
+  private:
+    // Decodes the next piece of the stream into `_chunk`, rewinding first if looping and at the
+    // end.  Returns the number of bytes decoded, or 0 if there is nothing left to play.
+    size_t decode() {
+        size_t size    = 0;
+        bool   rewound = false;
+        while (size < _chunk.size()) {
+            size_t n = _stream->read(_chunk.data() + size, _chunk.size() - size);
+            if (n > 0) {
+                size += n;
+                rewound = false;
+            } else if (_looping && !rewound) {
+                _stream->rewind();
+                rewound = true;
+            } else {
+                _ended = true;  // at the end, or a looping stream that is empty
+                break;
+            }
+        }
+        return size;
+    }
+
+    bool stopping() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _stop;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_ended) {
+            if (_wake.wait_for(
+                        lock, std::chrono::milliseconds(kStreamPollMs), [this] { return _stop; })) {
+                return;
+            }
+            lock.unlock();
+            refill();
+            lock.lock();
+        }
+    }
+
+    // Requeues each buffer that has finished playing with the next piece of the stream.  Errors
+    // are discarded before releasing the AL mutex, so that they never reach another thread.
+    void refill() {
+        ALint processed = 0;
+        {
+            std::lock_guard<std::mutex> al(_al_mutex);
+            alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+            alGetError();  // discard.
+        }
+        while ((processed-- > 0) && !stopping()) {
+            ALuint buffer;
+            {
+                std::lock_guard<std::mutex> al(_al_mutex);
+                alSourceUnqueueBuffers(_source, 1, &buffer);
+                if (alGetError() != AL_NO_ERROR) {
+                    return;
+                }
+            }
+            size_t size = decode();
+            if (size > 0) {
+                std::lock_guard<std::mutex> al(_al_mutex);
+                alBufferData(buffer, _format, _chunk.data(), size, _stream->frequency());
+                alSourceQueueBuffers(_source, 1, &buffer);
+                alGetError();  // discard.
+            }
+        }
+
+        // If the worker fell behind, the source stopped when its queue ran dry.
+        ALint queued = 0, state = AL_STOPPED;
+
+        std::lock_guard<std::mutex> al(_al_mutex);
+        alGetSourcei(_source, AL_BUFFERS_QUEUED, &queued);
+        alGetSourcei(_source, AL_SOURCE_STATE, &state);
+        if ((queued > 0) && (state == AL_STOPPED)) {
+            alSourcePlay(_source);
+        }
+        alGetError();  // discard.
+    }
+
+    std::mutex&                        _al_mutex;
+    const ALuint                       _source;
+    const std::unique_ptr<AudioStream> _stream;
+    const bool                         _looping;
+    const ALenum                       _format;
+    ALuint                             _buffers[kStreamBuffers];
+    std::vector<uint8_t>               _chunk;
+    bool                               _ended = false;  // set and read only by the decoder
+    memory::Charge                     _charge;
+
+    std::mutex              _mutex;
+    std::condition_variable _wake;
+    bool                    _stop = false;
+    std::thread             _thread;
+};
+
 class OpenAlSoundDriver::OpenAlSound : public Sound {
   public:
-    OpenAlSound(const OpenAlSoundDriver& driver) : _driver(driver), _buffer(generate_buffer()) {}
+    OpenAlSound(const OpenAlSoundDriver& driver)
+            : _driver(driver), _buffer(generate_buffer(driver)), _charge(memory::SOUNDS) {}
 
     ~OpenAlSound() {
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alDeleteBuffers(1, &_buffer);
         alGetError();  // discard.
     }
 
-    virtual void play(uint8_t volume);
+    virtual void play(uint8_t volume, int8_t pan);
     virtual void loop(uint8_t volume);
 
-    void buffer(const SoundData& s) {
-        ALenum format = (s.channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-        alBufferData(_buffer, format, s.data.data(), s.data.size(), s.frequency);
+    void buffer(const CachedSound& s) {
+        ALenum format = (s.channels() == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
+        alBufferData(_buffer, format, s.data().data(), s.data().size(), s.frequency());
         check_al_error("alBufferData");
+        _charge.reset(s.data().size());
     }
 
     ALuint buffer() const { return _buffer; }
 
   private:
-    static ALuint generate_buffer() {
-        ALuint buffer;
+    static ALuint generate_buffer(const OpenAlSoundDriver& driver) {
+        std::lock_guard<std::mutex> al(driver._al_mutex);
+        ALuint                      buffer;
         alGenBuffers(1, &buffer);
         check_al_error("alGenBuffers");
         return buffer;
@@ -81,30 +260,45 @@ class OpenAlSoundDriver::OpenAlSound : public Sound {
 
     const OpenAlSoundDriver& _driver;
     ALuint                   _buffer;
+    memory::Charge           _charge;
 };
 
 class OpenAlSoundDriver::OpenAlChannel : public SoundChannel {
   public:
     OpenAlChannel(OpenAlSoundDriver& driver) : _driver(driver) {
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alGenSources(1, &_source);
         check_al_error("alGenSources");
         alSourcef(_source, AL_PITCH, 1.0f);
         alSourcef(_source, AL_GAIN, 1.0f);
         check_al_error("alSourcef");
+        alSourcei(_source, AL_SOURCE_RELATIVE, AL_TRUE);
+        check_al_error("alSourcei");
     }
 
     ~OpenAlChannel() {
+        _streamer.reset();
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alDeleteSources(1, &_source);
         alGetError();  // discard.
     }
 
     void activate() override { _driver._active_channel = this; }
 
-    void play(const OpenAlSound& sound, uint8_t volume) {
+    // Pans by placing the source on a unit circle in front of the listener, so that distance
+    // attenuation (clamped at the reference distance of 1) leaves the gain alone.  OpenAL only
+    // positions mono sounds; stereo ones play as recorded.
+    void play(const OpenAlSound& sound, uint8_t volume, int8_t pan) {
         quiet();
 
+        const float x = std::max(-1.0f, std::min(1.0f, pan / 127.0f));
+        const float z = -sqrtf(1.0f - (x * x));
+
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alSourcef(_source, AL_GAIN, volume / 255.0f);
         check_al_error("alSourcef");
+        alSource3f(_source, AL_POSITION, x, 0.0f, z);
+        check_al_error("alSource3f");
         alSourcei(_source, AL_LOOPING, AL_FALSE);
         check_al_error("alSourcei");
         alSourcei(_source, AL_BUFFER, sound.buffer());
@@ -116,8 +310,11 @@ class OpenAlSoundDriver::OpenAlChannel : public SoundChannel {
     void loop(const OpenAlSound& sound, uint8_t volume) {
         quiet();
 
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alSourcef(_source, AL_GAIN, volume / 255.0f);
         check_al_error("alSourcef");
+        alSource3f(_source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+        check_al_error("alSource3f");
         alSourcei(_source, AL_LOOPING, AL_TRUE);
         check_al_error("alSourcei");
         alSourcei(_source, AL_BUFFER, sound.buffer());
@@ -126,18 +323,62 @@ class OpenAlSoundDriver::OpenAlChannel : public SoundChannel {
         check_al_error("alSourcePlay");
     }
 
+    void stream(std::unique_ptr<AudioStream> stream, bool looping, uint8_t volume) {
+        quiet();
+
+        {
+            std::lock_guard<std::mutex> al(_driver._al_mutex);
+            alSourcef(_source, AL_GAIN, volume / 255.0f);
+            check_al_error("alSourcef");
+            alSource3f(_source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+            check_al_error("alSource3f");
+            alSourcei(_source, AL_LOOPING, AL_FALSE);  // the Streamer loops by rewinding instead
+            check_al_error("alSourcei");
+            alSourcei(_source, AL_BUFFER, 0);
+            check_al_error("alSourcei");
+        }
+        _streamer.reset(new Streamer(_driver._al_mutex, _source, std::move(stream), looping));
+    }
+
+    // Stops the Streamer, if any, before taking the AL mutex; its worker needs the mutex to exit.
     void quiet() override {
+        _streamer.reset();
+        std::lock_guard<std::mutex> al(_driver._al_mutex);
         alSourceStop(_source);
         check_al_error("alSourceStop");
     }
 
   private:
-    OpenAlSoundDriver& _driver;
-    ALuint             _source;
+    OpenAlSoundDriver&        _driver;
+    ALuint                    _source;
+    std::unique_ptr<Streamer> _streamer;
 };
 
-void OpenAlSoundDriver::OpenAlSound::play(uint8_t volume) {
-    _driver._active_channel->play(*this, volume);
+// Music is opened when the Sound is, so that a missing or undecodable song is reported by
+// open_music(), but it is decoded only as it plays.  The first play takes the opened stream;
+// each later one opens the song again, to start from the beginning.
+class OpenAlSoundDriver::OpenAlMusic : public Sound {
+  public:
+    OpenAlMusic(const OpenAlSoundDriver& driver, pn::string_view path)
+            : _driver(driver), _path(path.copy()), _stream(Resource::music_stream(_path)) {}
+
+    virtual void play(uint8_t volume, int8_t pan) {
+        _driver._active_channel->stream(take(), false, volume);
+    }
+    virtual void loop(uint8_t volume) { _driver._active_channel->stream(take(), true, volume); }
+
+  private:
+    std::unique_ptr<AudioStream> take() {
+        return _stream ? std::move(_stream) : Resource::music_stream(_path);
+    }
+
+    const OpenAlSoundDriver&     _driver;
+    const pn::string             _path;
+    std::unique_ptr<AudioStream> _stream;
+};
+
+void OpenAlSoundDriver::OpenAlSound::play(uint8_t volume, int8_t pan) {
+    _driver._active_channel->play(*this, volume, pan);
 }
 
 void OpenAlSoundDriver::OpenAlSound::loop(uint8_t volume) {
@@ -162,18 +403,17 @@ unique_ptr<SoundChannel> OpenAlSoundDriver::open_channel() {
 
 unique_ptr<Sound> OpenAlSoundDriver::open_sound(pn::string_view path) {
     unique_ptr<OpenAlSound> sound(new OpenAlSound(*this));
-    SoundData               s = Resource::sound(path);
-    sound->buffer(s);
+    sound->buffer(CachedSound::load(path));
     return std::move(sound);
 }
 
 unique_ptr<Sound> OpenAlSoundDriver::open_music(pn::string_view path) {
-    unique_ptr<OpenAlSound> music(new OpenAlSound(*this));
-    SoundData               s = Resource::music(path);
-    music->buffer(s);
-    return std::move(music);
+    return unique_ptr<Sound>(new OpenAlMusic(*this, path));
 }
 
-void OpenAlSoundDriver::set_global_volume(uint8_t volume) { alListenerf(AL_GAIN, volume / 8.0); }
+void OpenAlSoundDriver::set_global_volume(uint8_t volume) {
+    std::lock_guard<std::mutex> al(_al_mutex);
+    alListenerf(AL_GAIN, volume / 8.0);
+}
 
 }  // namespace antares
@@ -20,6 +20,8 @@
 
 #include "data/audio.hpp"
 #include "data/resource.hpp"
+#include "data/sound-bank.hpp"
+#include "lang/memory.hpp"
 
 #include <pn/output>
 #include <stdexcept>
@@ -81,7 +83,8 @@ class XAudio2SoundDriver::XAudio2SoundInstance {
             : _driver(driver),
               _data(std::move(data)),
               _frequency_ratio(frequency_ratio),
-              _ref_count(1)
+              _ref_count(1),
+              _charge(memory::SOUNDS, _data.size())
     {}
 
     const BYTE* get_data() const { return _data.data(); }
@@ -101,6 +104,7 @@ class XAudio2SoundDriver::XAudio2SoundInstance {
     float                   _frequency_ratio;
     std::vector<BYTE>       _data;
     volatile LONG           _ref_count;
+    memory::Charge          _charge;
 };
 
 class XAudio2SoundDriver::XAudio2VoiceInstance {
@@ -182,25 +186,25 @@ class XAudio2SoundDriver::XAudio2Sound : public Sound {
     XAudio2Sound(XAudio2SoundDriver& driver)
             : _driver(driver), _instance(nullptr) {}
 
-    virtual void play(uint8_t volume);
+    virtual void play(uint8_t volume, int8_t pan);
     virtual void loop(uint8_t volume);
 
-    void buffer(const SoundData& s) {
+    void buffer(pn::data_view samples, int channels, int sample_rate) {
         if (_instance) {
             _instance->dec_ref();
             _instance = nullptr;
         }
 
-        if (s.channels == 0) {
+        if (channels == 0) {
             return;
         }
 
-        const size_t num_samples = s.data.size() / s.channels / sizeof(int16_t);
+        const size_t num_samples = samples.size() / channels / sizeof(int16_t);
         std::vector<BYTE> data = convert_to_stereo(
-                reinterpret_cast<const BYTE*>(s.data.data()), s.channels, num_samples);
+                reinterpret_cast<const BYTE*>(samples.data()), channels, num_samples);
 
         float  frequency_ratio =
-                static_cast<float>(s.frequency) / static_cast<float>(_driver.get_sample_rate());
+                static_cast<float>(sample_rate) / static_cast<float>(_driver.get_sample_rate());
 
         frequency_ratio = std::min(
                 XAUDIO2_MAX_FREQ_RATIO, std::max(XAUDIO2_MIN_FREQ_RATIO, frequency_ratio));
@@ -284,7 +288,8 @@ class XAudio2SoundDriver::XAudio2Channel : public SoundChannel {
     std::unique_ptr<XAudio2SourceVoiceInstance> _source_voice;
 };
 
-void XAudio2SoundDriver::XAudio2Sound::play(uint8_t volume) {
+// Sounds are centered; `pan` is not yet applied, e.g. with SetOutputMatrix().
+void XAudio2SoundDriver::XAudio2Sound::play(uint8_t volume, int8_t pan) {
     _driver._active_channel->play(*this, volume);
 }
 
@@ -333,15 +338,15 @@ unique_ptr<SoundChannel> XAudio2SoundDriver::open_channel() {
 
 unique_ptr<Sound> XAudio2SoundDriver::open_sound(pn::string_view path) {
     unique_ptr<XAudio2Sound> sound(new XAudio2Sound(*this));
-    SoundData               s = Resource::sound(path);
-    sound->buffer(s);
+    CachedSound              s = CachedSound::load(path);
+    sound->buffer(s.data(), s.channels(), s.frequency());
     return std::move(sound);
 }
 
 unique_ptr<Sound> XAudio2SoundDriver::open_music(pn::string_view path) {
     unique_ptr<XAudio2Sound> music(new XAudio2Sound(*this));
     SoundData               s = Resource::music(path);
-    music->buffer(s);
+    music->buffer(s.data, s.channels, s.frequency);
     return std::move(music);
 }
 
@@ -90,8 +90,12 @@ void InterfaceScreen::draw() const {
         copy_area = _bounds;
     } else {
         next()->draw();
-        copy_area = _widgets[0]->outer_bounds();
-        enlarge_to_outer_bounds(&copy_area, _widgets);
+        if (!_widget_bounds.has_value()) {
+            Rect r = _widgets[0]->outer_bounds();
+            enlarge_to_outer_bounds(&r, _widgets);
+            _widget_bounds.emplace(r);
+        }
+        copy_area = *_widget_bounds;
     }
     Point off = offset();
     copy_area.offset(off.h, off.v);
@@ -48,10 +48,10 @@ SelectLevelScreen::SelectLevelScreen(bool* cancelled, const Level** level)
           _cancelled(cancelled),
           _level(level) {
     sys.ledger->unlocked_chapters(&_chapters);
-    _index  = _chapters.size() - 1;
-    *_level = Level::get(_chapters[_index]);
+    _index = _chapters.size() - 1;
 
     button(OK)->bind({[this] {
+        *_level     = Level::get(_chapters[_index]);
         _state      = FADING_OUT;
         *_cancelled = false;
         stack()->push(new ColorFade(ColorFade::TO_COLOR, RgbColor::black(), secs(1), false, NULL));
@@ -66,7 +66,6 @@ SelectLevelScreen::SelectLevelScreen(bool* cancelled, const Level** level)
             [this] {
                 if (_index > 0) {
                     --_index;
-                    *_level = Level::get(_chapters[_index]);
                 }
             },
             [this] { return _index > 0; },
@@ -76,7 +75,6 @@ SelectLevelScreen::SelectLevelScreen(bool* cancelled, const Level** level)
             [this] {
                 if (_index < _chapters.size() - 1) {
                     ++_index;
-                    *_level = Level::get(_chapters[_index]);
                 }
             },
             [this] { return _index < _chapters.size() - 1; },
@@ -114,7 +112,7 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
                 case Key::N_TIMES:
                     _state          = UNLOCKING;
                     _unlock_chapter = 0;
-                    _unlock_digits  = ndigits(plug.levels.size());
+                    _unlock_digits  = ndigits(plug.level_index.size());
                     sys.sound.cloak_on();
                     return;
                 default: break;
@@ -138,7 +136,6 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
                 sys.ledger->unlocked_chapters(&_chapters);
                 _index = std::find(_chapters.begin(), _chapters.end(), _unlock_chapter) -
                          _chapters.begin();
-                *_level = Level::get(_chapters[_index]);
             }
             return;
         } break;
@@ -150,8 +147,14 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
 
 void SelectLevelScreen::overlay() const { draw_level_name(); }
 
+// Titles come from the level index, so that browsing the list doesn't build each level in full.
+// The chosen level is built when it is confirmed.
 void SelectLevelScreen::draw_level_name() const {
-    const pn::string_view chapter_name = (*_level)->base.name;
+    auto it = plug.level_index.find(plug.chapters[_chapters[_index]]);
+    if (it == plug.level_index.end()) {
+        return;
+    }
+    const pn::string_view chapter_name = it->second.title;
 
     const Widget& i = *widget(NAME);
 
@@ -22,6 +22,7 @@
 #include "config/keys.hpp"
 #include "data/resource.hpp"
 #include "drawing/interface.hpp"
+#include "drawing/styled-text.hpp"
 #include "drawing/text.hpp"
 
 using std::unique_ptr;
@@ -49,8 +50,9 @@ static const int32_t kMaxKeyNameLength =
 //  Relies on roman alphabet for upper/lower casing.  NOT WORLD-READY!
 
 static void DrawInterfaceString(
-        Point p, pn::string_view s, InterfaceStyle style, const RgbColor& color) {
-    interface_font(style).draw(p, s, color);
+        DisplayList* list, Point p, pn::string_view s, InterfaceStyle style,
+        const RgbColor& color) {
+    list->text(interface_font(style), p, s, color);
 }
 
 static int16_t GetInterfaceStringWidth(pn::string_view s, InterfaceStyle style) {
@@ -76,28 +78,28 @@ static int16_t GetInterfaceFontAscent(InterfaceStyle style) {
     return interface_font(style).ascent;
 }
 
-inline void mDrawPuffUpRect(const Rects& rects, Rect r, Hue hue, int mshade) {
+inline void mDrawPuffUpRect(DisplayList* list, Rect r, Hue hue, int mshade) {
     const RgbColor color = GetRGBTranslateColorShade(hue, mshade);
-    rects.fill(r, color);
+    list->fill(r, color);
     const RgbColor lighter = GetRGBTranslateColorShade(hue, mshade + kLighterColor);
-    rects.fill(Rect(r.left, r.top, r.left + 1, r.bottom), lighter);
-    rects.fill(Rect(r.left, r.top, r.right - 1, r.top + 1), lighter);
+    list->fill(Rect(r.left, r.top, r.left + 1, r.bottom), lighter);
+    list->fill(Rect(r.left, r.top, r.right - 1, r.top + 1), lighter);
     const RgbColor darker = GetRGBTranslateColorShade(hue, mshade + kDarkerColor);
-    rects.fill(Rect(r.right - 1, r.top, r.right, r.bottom), darker);
-    rects.fill(Rect(r.left + 1, r.bottom - 1, r.right, r.bottom), darker);
+    list->fill(Rect(r.right - 1, r.top, r.right, r.bottom), darker);
+    list->fill(Rect(r.left + 1, r.bottom - 1, r.right, r.bottom), darker);
 }
 
-inline void mDrawPuffDownRect(const Rects& rects, Rect r, Hue hue, int mshade) {
-    rects.fill(r, RgbColor::black());
+inline void mDrawPuffDownRect(DisplayList* list, Rect r, Hue hue, int mshade) {
+    list->fill(r, RgbColor::black());
     const RgbColor darker = GetRGBTranslateColorShade(hue, mshade + kDarkerColor);
-    rects.fill(Rect(r.left - 1, r.top - 1, r.left, r.bottom + 1), darker);
-    rects.fill(Rect(r.left - 1, r.top - 1, r.right, r.top), darker);
+    list->fill(Rect(r.left - 1, r.top - 1, r.left, r.bottom + 1), darker);
+    list->fill(Rect(r.left - 1, r.top - 1, r.right, r.top), darker);
     const RgbColor lighter = GetRGBTranslateColorShade(hue, mshade + kLighterColor);
-    rects.fill(Rect(r.right, r.top - 1, r.right + 1, r.bottom + 1), lighter);
-    rects.fill(Rect(r.left, r.bottom, r.right + 1, r.bottom + 1), lighter);
+    list->fill(Rect(r.right, r.top - 1, r.right + 1, r.bottom + 1), lighter);
+    list->fill(Rect(r.left, r.bottom, r.right + 1, r.bottom + 1), lighter);
 }
 
-static void mDrawPuffUpTopBorder(const Rects& rects, Rect r, Hue hue, int shade, int h_border) {
+static void mDrawPuffUpTopBorder(DisplayList* list, Rect r, Hue hue, int shade, int h_border) {
     // For historical reasons, this function assumes r has closed intervals.
     ++r.right;
     ++r.bottom;
@@ -106,22 +108,22 @@ static void mDrawPuffUpTopBorder(const Rects& rects, Rect r, Hue hue, int shade,
             r.left - h_border, r.top - kInterfaceVEdgeHeight - kInterfaceVCornerHeight,
             r.right + h_border, r.top - kInterfaceVLipHeight);
     const RgbColor color = GetRGBTranslateColorShade(hue, shade);
-    rects.fill(Rect(outer.left, outer.top, r.left, r.top), color);
-    rects.fill(Rect(r.right, outer.top, outer.right, r.top), color);
-    rects.fill(Rect(r.left, outer.top, r.right, outer.bottom), color);
+    list->fill(Rect(outer.left, outer.top, r.left, r.top), color);
+    list->fill(Rect(r.right, outer.top, outer.right, r.top), color);
+    list->fill(Rect(r.left, outer.top, r.right, outer.bottom), color);
 
     const RgbColor darker = GetRGBTranslateColorShade(hue, shade + kDarkerColor);
-    rects.fill(Rect(outer.left, r.top, r.left + 1, r.top + 1), darker);
-    rects.fill(Rect(r.left, outer.bottom, r.right, outer.bottom + 1), darker);
-    rects.fill(Rect(r.right - 1, r.top, outer.right, r.top + 1), darker);
-    rects.fill(Rect(outer.right - 1, outer.top + 1, outer.right, r.top), darker);
+    list->fill(Rect(outer.left, r.top, r.left + 1, r.top + 1), darker);
+    list->fill(Rect(r.left, outer.bottom, r.right, outer.bottom + 1), darker);
+    list->fill(Rect(r.right - 1, r.top, outer.right, r.top + 1), darker);
+    list->fill(Rect(outer.right - 1, outer.top + 1, outer.right, r.top), darker);
 
     const RgbColor lighter = GetRGBTranslateColorShade(hue, shade + kLighterColor);
-    rects.fill(Rect(outer.left, outer.top, outer.left + 1, r.top), lighter);
-    rects.fill(Rect(outer.left, outer.top, outer.right, outer.top + 1), lighter);
+    list->fill(Rect(outer.left, outer.top, outer.left + 1, r.top), lighter);
+    list->fill(Rect(outer.left, outer.top, outer.right, outer.top + 1), lighter);
 }
 
-static void mDrawPuffUpBottomBorder(const Rects& rects, Rect r, Hue hue, int shade, int h_border) {
+static void mDrawPuffUpBottomBorder(DisplayList* list, Rect r, Hue hue, int shade, int h_border) {
     // For historical reasons, this function assumes r has closed intervals.
     ++r.right;
     ++r.bottom;
@@ -131,69 +133,69 @@ static void mDrawPuffUpBottomBorder(const Rects& rects, Rect r, Hue hue, int sha
             r.bottom + kInterfaceVEdgeHeight + kInterfaceVCornerHeight);
 
     const RgbColor color = GetRGBTranslateColorShade(hue, shade);
-    rects.fill(Rect(outer.left, r.bottom, r.left, outer.bottom), color);
-    rects.fill(Rect(r.right, r.bottom, outer.right, outer.bottom), color);
-    rects.fill(Rect(r.left, outer.top, r.right, outer.bottom), color);
+    list->fill(Rect(outer.left, r.bottom, r.left, outer.bottom), color);
+    list->fill(Rect(r.right, r.bottom, outer.right, outer.bottom), color);
+    list->fill(Rect(r.left, outer.top, r.right, outer.bottom), color);
 
     const RgbColor lighter = GetRGBTranslateColorShade(hue, shade + kLighterColor);
-    rects.fill(Rect(outer.left, r.bottom - 1, outer.left + 1, outer.bottom), lighter);
-    rects.fill(Rect(outer.left, r.bottom - 1, r.left + 1, r.bottom), lighter);
-    rects.fill(Rect(r.left, outer.top - 1, r.right, outer.top), lighter);
-    rects.fill(Rect(r.right - 1, r.bottom - 1, outer.right, r.bottom), lighter);
+    list->fill(Rect(outer.left, r.bottom - 1, outer.left + 1, outer.bottom), lighter);
+    list->fill(Rect(outer.left, r.bottom - 1, r.left + 1, r.bottom), lighter);
+    list->fill(Rect(r.left, outer.top - 1, r.right, outer.top), lighter);
+    list->fill(Rect(r.right - 1, r.bottom - 1, outer.right, r.bottom), lighter);
 
     const RgbColor darker = GetRGBTranslateColorShade(hue, shade + kDarkerColor);
-    rects.fill(Rect(outer.left + 1, outer.bottom - 1, outer.right, outer.bottom), darker);
-    rects.fill(Rect(outer.right - 1, r.bottom - 1, outer.right, outer.bottom), darker);
+    list->fill(Rect(outer.left + 1, outer.bottom - 1, outer.right, outer.bottom), darker);
+    list->fill(Rect(outer.right - 1, r.bottom - 1, outer.right, outer.bottom), darker);
 }
 
 static void mDrawPuffUpTBorder(
-        const Rects& rects, Rect r, Hue hue, int mshade, int msheight, int h_border) {
+        DisplayList* list, Rect r, Hue hue, int mshade, int msheight, int h_border) {
     ++r.right;
     ++r.bottom;
 
     const RgbColor color = GetRGBTranslateColorShade(hue, mshade);
-    rects.fill(
+    list->fill(
             Rect(r.left - h_border, r.top + msheight, r.left + 1,
                  r.top + msheight + kLabelBottomHeight + 1),
             color);
-    rects.fill(
+    list->fill(
             Rect(r.right - 1, r.top + msheight, r.right + h_border,
                  r.top + msheight + kLabelBottomHeight + 1),
             color);
-    rects.fill(
+    list->fill(
             Rect(r.left, r.top + msheight + kInterfaceVLipHeight, r.right,
                  r.top + msheight + kLabelBottomHeight - kInterfaceVLipHeight + 1),
             color);
 
     const RgbColor lighter = GetRGBTranslateColorShade(hue, mshade + kLighterColor);
-    rects.fill(
+    list->fill(
             Rect(r.left - h_border, r.top + msheight, r.left - h_border + 1,
                  r.top + msheight + kLabelBottomHeight + 1),
             lighter);
-    rects.fill(
+    list->fill(
             Rect(r.left - h_border, r.top + msheight, r.left + 1, r.top + msheight + 1), lighter);
-    rects.fill(
+    list->fill(
             Rect(r.left, r.top + msheight + kInterfaceVLipHeight, r.right,
                  r.top + msheight + kInterfaceVLipHeight + 1),
             lighter);
-    rects.fill(
+    list->fill(
             Rect(r.right - 1, r.top + msheight, r.right + h_border - 1, r.top + msheight + 1),
             lighter);
 
     const RgbColor darker = GetRGBTranslateColorShade(hue, mshade + kDarkerColor);
-    rects.fill(
+    list->fill(
             Rect(r.left - h_border + 1, r.top + msheight + kLabelBottomHeight, r.left + 1,
                  r.top + msheight + kLabelBottomHeight + 1),
             darker);
-    rects.fill(
+    list->fill(
             Rect(r.left, r.top + msheight + kLabelBottomHeight - kInterfaceVLipHeight, r.right,
                  r.top + msheight + kLabelBottomHeight - kInterfaceVLipHeight + 1),
             darker);
-    rects.fill(
+    list->fill(
             Rect(r.right - 1, r.top + msheight + kLabelBottomHeight, r.right + h_border,
                  r.top + msheight + kLabelBottomHeight + 1),
             darker);
-    rects.fill(
+    list->fill(
             Rect(r.right + h_border - 1, r.top + msheight, r.right + h_border,
                  r.top + msheight + kLabelBottomHeight + 1),
             darker);
@@ -213,6 +215,23 @@ static int h_border(InterfaceStyle style) {
 
 Widget::~Widget() = default;
 
+void Widget::draw(Point origin, InputMode mode) const {
+    const uint64_t state = this->state();
+    if (!_display_valid || (origin != _display_origin) || (mode != _display_mode) ||
+        (state != _display_state)) {
+        _display.clear();
+        record(&_display, origin, mode);
+        _display_valid  = true;
+        _display_origin = origin;
+        _display_mode   = mode;
+        _display_state  = state;
+    }
+    _display.draw();
+}
+
+uint64_t Widget::state() const { return 0; }
+void     Widget::record(DisplayList* list, Point origin, InputMode mode) const {}
+
 Widget* Widget::accept_click(Point where) { return nullptr; }
 Widget* Widget::accept_key(Key which) { return nullptr; }
 Widget* Widget::accept_button(Gamepad::Button which) { return nullptr; }
@@ -232,15 +251,15 @@ BoxRect::BoxRect(const BoxRectData& data)
           _hue{data.hue},
           _style{data.style} {}
 
-void BoxRect::draw(Point offset, InputMode) const {
+void BoxRect::record(DisplayList* list, Point offset, InputMode) const {
     if (_label.has_value()) {
-        draw_labeled_box(offset);
+        record_labeled_box(list, offset);
     } else {
-        draw_plain_rect(offset);
+        record_plain_rect(list, offset);
     }
 }
 
-void BoxRect::draw_labeled_box(Point origin) const {
+void BoxRect::record_labeled_box(DisplayList* list, Point origin) const {
     Rect     tRect, uRect;
     int16_t  vcenter, swidth, sheight, thisHBorder = kInterfaceSmallHBorder;
     uint8_t  shade;
@@ -259,10 +278,10 @@ void BoxRect::draw_labeled_box(Point origin) const {
 
     shade = DARK;
 
-    mDrawPuffUpTopBorder(Rects(), tRect, _hue, shade, thisHBorder);
+    mDrawPuffUpTopBorder(list, tRect, _hue, shade, thisHBorder);
     // bottom border
 
-    mDrawPuffUpBottomBorder(Rects(), tRect, _hue, shade, thisHBorder);
+    mDrawPuffUpBottomBorder(list, tRect, _hue, shade, thisHBorder);
 
     // draw the string
 
@@ -276,11 +295,12 @@ void BoxRect::draw_labeled_box(Point origin) const {
                  tRect.right - swidth - kInterfaceTextHBuffer + 1,
                  tRect.top + sheight - kInterfaceHTop);
     color = GetRGBTranslateColorShade(_hue, VERY_DARK);
-    Rects().fill(uRect, color);
+    list->fill(uRect, color);
 
     color = GetRGBTranslateColorShade(_hue, LIGHT);
 
     DrawInterfaceString(
+            list,
             Point(tRect.left + kInterfaceTextHBuffer,
                   tRect.top + GetInterfaceFontAscent(_style) + kInterfaceTextVBuffer),
             s, _style, color);
@@ -293,7 +313,7 @@ void BoxRect::draw_labeled_box(Point origin) const {
     uRect =
             Rect(tRect.left - thisHBorder, tRect.top + kInterfaceHTop, tRect.left + 1,
                  tRect.top + sheight - kInterfaceHTop + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, shade);
+    mDrawPuffUpRect(list, uRect, _hue, shade);
 
     // string right border
 
@@ -301,15 +321,15 @@ void BoxRect::draw_labeled_box(Point origin) const {
     uRect =
             Rect(tRect.right - swidth, tRect.top + kInterfaceHTop, tRect.right - 2,
                  tRect.top + sheight - kInterfaceHTop + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, shade);
+    mDrawPuffUpRect(list, uRect, _hue, shade);
     uRect =
             Rect(tRect.right, tRect.top + kInterfaceHTop, tRect.right + thisHBorder + 1,
                  tRect.top + sheight - kInterfaceHTop + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, shade);
+    mDrawPuffUpRect(list, uRect, _hue, shade);
 
     // string bottom border
 
-    mDrawPuffUpTBorder(Rects(), tRect, _hue, DARK, sheight, thisHBorder);
+    mDrawPuffUpTBorder(list, tRect, _hue, DARK, sheight, thisHBorder);
 
     // main part left border
 
@@ -320,28 +340,27 @@ void BoxRect::draw_labeled_box(Point origin) const {
     uRect =
             Rect(tRect.left - thisHBorder, tRect.top + kInterfaceHTop, tRect.left + 1,
                  tRect.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, DARKER);
+    mDrawPuffUpRect(list, uRect, _hue, DARKER);
 
     uRect =
             Rect(tRect.left - thisHBorder, tRect.bottom - vcenter + kInterfaceVLipHeight,
                  tRect.left + 1, tRect.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, _hue, VERY_DARK);
 
     // right border
 
     uRect =
             Rect(tRect.right, tRect.top + kInterfaceHTop, tRect.right + thisHBorder + 1,
                  tRect.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, DARKER);
+    mDrawPuffUpRect(list, uRect, _hue, DARKER);
 
     uRect =
             Rect(tRect.right, tRect.bottom - vcenter + kInterfaceVLipHeight,
                  tRect.right + thisHBorder + 1, tRect.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(Rects(), uRect, _hue, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, _hue, VERY_DARK);
 }
 
-void BoxRect::draw_plain_rect(Point origin) const {
-    Rects          rects;
+void BoxRect::record_plain_rect(DisplayList* list, Point origin) const {
     Rect           tRect, uRect;
     int16_t        vcenter, thisHBorder = kInterfaceSmallHBorder;
     Hue            color = _hue;
@@ -358,10 +377,10 @@ void BoxRect::draw_plain_rect(Point origin) const {
     tRect.bottom += kInterfaceContentBuffer;
 
     // top border
-    mDrawPuffUpTopBorder(rects, tRect, color, DARK, thisHBorder);
+    mDrawPuffUpTopBorder(list, tRect, color, DARK, thisHBorder);
     // bottom border
 
-    mDrawPuffUpBottomBorder(rects, tRect, color, DARK, thisHBorder);
+    mDrawPuffUpBottomBorder(list, tRect, color, DARK, thisHBorder);
 
     // main part left border
 
@@ -370,24 +389,24 @@ void BoxRect::draw_plain_rect(Point origin) const {
     uRect =
             Rect(tRect.left - thisHBorder, tRect.top + kInterfaceHTop, tRect.left + 1,
                  tRect.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(rects, uRect, color, DARKER);
+    mDrawPuffUpRect(list, uRect, color, DARKER);
 
     uRect =
             Rect(tRect.left - thisHBorder, tRect.bottom - vcenter + kInterfaceVLipHeight,
                  tRect.left + 1, tRect.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(rects, uRect, color, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, color, VERY_DARK);
 
     // right border
 
     uRect =
             Rect(tRect.right, tRect.top + kInterfaceHTop, tRect.right + thisHBorder + 1,
                  tRect.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(rects, uRect, color, DARKER);
+    mDrawPuffUpRect(list, uRect, color, DARKER);
 
     uRect =
             Rect(tRect.right, tRect.bottom - vcenter + kInterfaceVLipHeight,
                  tRect.right + thisHBorder + 1, tRect.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(rects, uRect, color, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, color, VERY_DARK);
 }
 
 Rect BoxRect::inner_bounds() const { return _inner_bounds; }
@@ -413,10 +432,19 @@ TextRect::TextRect(const TextRectData& data)
           _hue{data.hue},
           _style{data.style} {}
 
+// Like draw_text_in_rect(), but the text never changes, so it is only wrapped once.
 void TextRect::draw(Point offset, InputMode) const {
     Rect bounds = _inner_bounds;
     bounds.offset(offset.h, offset.v);
-    draw_text_in_rect(bounds, _text.has_value() ? _text->copy() : pn::string_view{}, _style, _hue);
+    if (!_styled_text) {
+        _styled_text.reset(new StyledText(StyledText::interface(
+                _text.has_value() ? _text->copy() : pn::string_view{},
+                {interface_font(_style), bounds.width(), kInterfaceTextHBuffer,
+                 kInterfaceTextVBuffer},
+                GetRGBTranslateColorShade(_hue, LIGHTEST))));
+    }
+    bounds.offset(0, -kInterfaceTextVBuffer);
+    _styled_text->draw(bounds);
 }
 
 Rect TextRect::inner_bounds() const { return _inner_bounds; }
@@ -433,10 +461,10 @@ Rect TextRect::outer_bounds() const {
 PictureRect::PictureRect(const PictureRectData& data)
         : _inner_bounds(data.bounds), _id{data.id}, _texture{Resource::texture(data.picture)} {}
 
-void PictureRect::draw(Point offset, InputMode) const {
+void PictureRect::record(DisplayList* list, Point offset, InputMode) const {
     Rect bounds = _inner_bounds;
     bounds.offset(offset.h, offset.v);
-    _texture.draw(bounds.left, bounds.top);
+    list->picture(_texture, Point(bounds.left, bounds.top));
 }
 
 Rect PictureRect::inner_bounds() const { return _inner_bounds; }
@@ -458,6 +486,11 @@ Button::Button(const ButtonData& data)
           _hue{data.hue},
           _style{data.style} {}
 
+uint64_t Button::state() const {
+    return (uint64_t(_key) << 32) | (uint64_t(_hue) << 8) | (uint64_t(_active) << 1) |
+           uint64_t(enabled());
+}
+
 Widget* Button::accept_click(Point where) {
     if (enabled() && (outer_bounds().contains(where))) {
         return this;
@@ -499,14 +532,13 @@ bool PlainButton::enabled() const {
     }
 }
 
-void PlainButton::draw(Point offset, InputMode mode) const {
+void PlainButton::record(DisplayList* list, Point offset, InputMode mode) const {
     Rect     tRect, uRect, vRect;
     int16_t  swidth, sheight, thisHBorder = kInterfaceSmallHBorder;
     uint8_t  shade;
     RgbColor color;
 
     {
-        Rects rects;
         if (style() == InterfaceStyle::LARGE) {
             thisHBorder = kInterfaceLargeHBorder;
         }
@@ -530,10 +562,10 @@ void PlainButton::draw(Point offset, InputMode mode) const {
             shade = MEDIUM;
         }
 
-        mDrawPuffUpTopBorder(rects, tRect, hue(), shade, thisHBorder);
+        mDrawPuffUpTopBorder(list, tRect, hue(), shade, thisHBorder);
         // bottom border
 
-        mDrawPuffUpBottomBorder(rects, tRect, hue(), shade, thisHBorder);
+        mDrawPuffUpBottomBorder(list, tRect, hue(), shade, thisHBorder);
 
         // side border top
 
@@ -545,16 +577,16 @@ void PlainButton::draw(Point offset, InputMode mode) const {
                      tRect.bottom - kInterfaceHTop + 1);
         if (active()) {
             shade = LIGHT;
-            mDrawPuffUpRect(rects, uRect, hue(), shade);
-            mDrawPuffUpRect(rects, vRect, hue(), shade);
+            mDrawPuffUpRect(list, uRect, hue(), shade);
+            mDrawPuffUpRect(list, vRect, hue(), shade);
         } else {
             if (!enabled()) {
                 shade = VERY_DARK;
             } else {
                 shade = MEDIUM + kSlightlyLighterColor;
             }
-            mDrawPuffUpRect(rects, uRect, hue(), shade);
-            mDrawPuffUpRect(rects, vRect, hue(), shade);
+            mDrawPuffUpRect(list, uRect, hue(), shade);
+            mDrawPuffUpRect(list, vRect, hue(), shade);
         }
     }
 
@@ -583,7 +615,7 @@ void PlainButton::draw(Point offset, InputMode mode) const {
                      tRect.bottom - kInterfaceContentBuffer + 1);
 
         color = GetRGBTranslateColorShade(hue(), shade);
-        Rects().fill(uRect, color);
+        list->fill(uRect, color);
 
         if (active()) {
             color = GetRGBTranslateColorShade(hue(), DARKEST);
@@ -595,11 +627,10 @@ void PlainButton::draw(Point offset, InputMode mode) const {
         swidth  = GetInterfaceStringWidth(label(), style());
         swidth  = tRect.left + (tRect.right - tRect.left) / 2 - swidth / 2;
         sheight = GetInterfaceFontAscent(style()) + kInterfaceTextVBuffer + tRect.top;
-        DrawInterfaceString(Point(swidth, sheight), label(), style(), color);
+        DrawInterfaceString(list, Point(swidth, sheight), label(), style(), color);
     } else {
         // draw the key code
         {
-            Rects rects;
             if (!enabled())
                 shade = VERY_DARK;
             else
@@ -610,7 +641,7 @@ void PlainButton::draw(Point offset, InputMode mode) const {
                     tRect.left + kInterfaceContentBuffer, tRect.top + kInterfaceContentBuffer,
                     tRect.left + kInterfaceContentBuffer + swidth + kInterfaceTextHBuffer * 2 + 1,
                     tRect.bottom - kInterfaceContentBuffer + 1);
-            mDrawPuffUpRect(rects, uRect, hue(), shade);
+            mDrawPuffUpRect(list, uRect, hue(), shade);
 
             if (active())
                 shade = LIGHT;
@@ -621,7 +652,7 @@ void PlainButton::draw(Point offset, InputMode mode) const {
                     tRect.top + kInterfaceContentBuffer, tRect.right - kInterfaceContentBuffer + 1,
                     tRect.bottom - kInterfaceContentBuffer + 1);
             color = GetRGBTranslateColorShade(hue(), shade);
-            rects.fill(vRect, color);
+            list->fill(vRect, color);
 
             swidth = GetInterfaceStringWidth(shortcut_text, style());
             swidth = uRect.left + (uRect.right - uRect.left) / 2 - swidth / 2;
@@ -633,8 +664,8 @@ void PlainButton::draw(Point offset, InputMode mode) const {
         }
 
         DrawInterfaceString(
-                Point(swidth, uRect.top + GetInterfaceFontAscent(style())), shortcut_text, style(),
-                color);
+                list, Point(swidth, uRect.top + GetInterfaceFontAscent(style())), shortcut_text,
+                style(), color);
 
         // draw the button title
         {
@@ -650,7 +681,7 @@ void PlainButton::draw(Point offset, InputMode mode) const {
             swidth            = GetInterfaceStringWidth(s, style());
             swidth            = uRect.right + (tRect.right - uRect.right) / 2 - swidth / 2;
             sheight = GetInterfaceFontAscent(style()) + kInterfaceTextVBuffer + tRect.top;
-            DrawInterfaceString(Point(swidth, sheight), s, style(), color);
+            DrawInterfaceString(list, Point(swidth, sheight), s, style(), color);
         }
     }
 }
@@ -684,7 +715,9 @@ bool CheckboxButton::enabled() const {
 
 void CheckboxButton::action() { set(!get()); }
 
-void CheckboxButton::draw(Point offset, InputMode) const {
+uint64_t CheckboxButton::state() const { return Button::state() | (uint64_t(get()) << 2); }
+
+void CheckboxButton::record(DisplayList* list, Point offset, InputMode) const {
     Rect     tRect, uRect, vRect, wRect;
     int16_t  swidth, sheight, thisHBorder = kInterfaceSmallHBorder;
     uint8_t  shade;
@@ -707,10 +740,10 @@ void CheckboxButton::draw(Point offset, InputMode) const {
     else
         shade = MEDIUM;
 
-    mDrawPuffUpTopBorder(Rects(), tRect, hue(), shade, thisHBorder);
+    mDrawPuffUpTopBorder(list, tRect, hue(), shade, thisHBorder);
     // bottom border
 
-    mDrawPuffUpBottomBorder(Rects(), tRect, hue(), shade, thisHBorder);
+    mDrawPuffUpBottomBorder(list, tRect, hue(), shade, thisHBorder);
 
     // side border top
 
@@ -732,28 +765,28 @@ void CheckboxButton::draw(Point offset, InputMode) const {
 
     if (active()) {
         shade = LIGHT;
-        mDrawPuffUpRect(Rects(), uRect, hue(), shade);
-        mDrawPuffUpRect(Rects(), vRect, hue(), shade);
-        mDrawPuffUpRect(Rects(), wRect, hue(), shade);
+        mDrawPuffUpRect(list, uRect, hue(), shade);
+        mDrawPuffUpRect(list, vRect, hue(), shade);
+        mDrawPuffUpRect(list, wRect, hue(), shade);
         wRect.inset(3, 3);
-        mDrawPuffDownRect(Rects(), wRect, hue(), shade);
+        mDrawPuffDownRect(list, wRect, hue(), shade);
         wRect.inset(1, 1);
         if (!get()) {
             color = RgbColor::black();
         } else {
             color = GetRGBTranslateColorShade(hue(), LIGHTEST);
         }
-        Rects().fill(wRect, color);
+        list->fill(wRect, color);
     } else {
         if (!enabled())
             shade = VERY_DARK;
         else
             shade = MEDIUM + kSlightlyLighterColor;
-        mDrawPuffUpRect(Rects(), uRect, hue(), shade);
-        mDrawPuffUpRect(Rects(), vRect, hue(), shade);
-        mDrawPuffUpRect(Rects(), wRect, hue(), shade);
+        mDrawPuffUpRect(list, uRect, hue(), shade);
+        mDrawPuffUpRect(list, vRect, hue(), shade);
+        mDrawPuffUpRect(list, wRect, hue(), shade);
         wRect.inset(3, 3);
-        mDrawPuffDownRect(Rects(), wRect, hue(), shade);
+        mDrawPuffDownRect(list, wRect, hue(), shade);
         wRect.inset(1, 1);
         if (!get()) {
             color = RgbColor::black();
@@ -762,7 +795,7 @@ void CheckboxButton::draw(Point offset, InputMode) const {
         } else {
             color = GetRGBTranslateColorShade(hue(), MEDIUM);
         }
-        Rects().fill(wRect, color);
+        list->fill(wRect, color);
     }
 
     uRect =
@@ -777,7 +810,7 @@ void CheckboxButton::draw(Point offset, InputMode) const {
             tRect.left + kInterfaceContentBuffer, tRect.top + kInterfaceContentBuffer,
             tRect.right - kInterfaceContentBuffer + 1, tRect.bottom - kInterfaceContentBuffer + 1);
     color = GetRGBTranslateColorShade(hue(), shade);
-    Rects().fill(uRect, color);
+    list->fill(uRect, color);
 
     if (active()) {
         color = GetRGBTranslateColorShade(hue(), DARKEST);
@@ -791,7 +824,7 @@ void CheckboxButton::draw(Point offset, InputMode) const {
     swidth            = GetInterfaceStringWidth(s, style());
     swidth            = tRect.left + (tRect.right - tRect.left) / 2 - swidth / 2;
     sheight           = GetInterfaceFontAscent(style()) + kInterfaceTextVBuffer + tRect.top;
-    DrawInterfaceString(Point(swidth, sheight), s, style(), color);
+    DrawInterfaceString(list, Point(swidth, sheight), s, style(), color);
 }
 
 Rect CheckboxButton::inner_bounds() const { return _inner_bounds; }
@@ -809,7 +842,7 @@ Rect CheckboxButton::outer_bounds() const {
 
 RadioButton::RadioButton(const RadioButtonData& data) : Button{data}, _inner_bounds{data.bounds} {}
 
-void RadioButton::draw(Point offset, InputMode) const {
+void RadioButton::record(DisplayList* list, Point offset, InputMode) const {
     /*
     Rect     tRect, uRect, vRect, wRect;
     int16_t  vcenter, swidth, sheight, thisHBorder = kInterfaceSmallHBorder;
@@ -971,7 +1004,9 @@ TabButton::TabButton(TabBox* box, const TabBoxData::Tab& data, Rect bounds)
 
 void TabButton::action() { parent()->select(*this); }
 
-void TabButton::draw(Point offset, InputMode) const {
+uint64_t TabButton::state() const { return Button::state() | (uint64_t(_on) << 2); }
+
+void TabButton::record(DisplayList* list, Point offset, InputMode) const {
     Rect     tRect;
     int16_t  swidth, sheight, h_border = kInterfaceSmallHBorder;
     uint8_t  shade;
@@ -996,7 +1031,7 @@ void TabButton::draw(Point offset, InputMode) const {
         shade = MEDIUM;
     }
 
-    mDrawPuffUpTopBorder(Rects(), tRect, hue(), shade, h_border);
+    mDrawPuffUpTopBorder(list, tRect, hue(), shade, h_border);
 
     // side border top
 
@@ -1007,33 +1042,31 @@ void TabButton::draw(Point offset, InputMode) const {
             tRect.right, tRect.top + kInterfaceHTop, tRect.right + h_border + 1,
             tRect.bottom - kInterfaceHTop + 1);
     if (!on()) {
-        Rects rects;
         if (active()) {
             shade = LIGHT;
-            mDrawPuffUpRect(rects, left, hue(), shade);
-            mDrawPuffUpRect(rects, right, hue(), shade);
+            mDrawPuffUpRect(list, left, hue(), shade);
+            mDrawPuffUpRect(list, right, hue(), shade);
         } else {
             if (!enabled()) {
                 shade = VERY_DARK;
             } else
                 shade = DARK;
-            mDrawPuffUpRect(rects, left, hue(), shade);
-            mDrawPuffUpRect(rects, right, hue(), shade);
+            mDrawPuffUpRect(list, left, hue(), shade);
+            mDrawPuffUpRect(list, right, hue(), shade);
         }
         left  = Rect(left.left, left.bottom, left.right, left.bottom + 3);
         right = Rect(right.left, right.bottom, right.right, right.bottom + 3);
-        rects.fill(left, RgbColor::black());
-        rects.fill(right, RgbColor::black());
+        list->fill(left, RgbColor::black());
+        list->fill(right, RgbColor::black());
         shade = MEDIUM;
         color = GetRGBTranslateColorShade(hue(), shade);
-        rects.fill(Rect(left.left - 3, left.bottom, right.right + 3, left.bottom + 3), color);
+        list->fill(Rect(left.left - 3, left.bottom, right.right + 3, left.bottom + 3), color);
 
         const RgbColor lighter = GetRGBTranslateColorShade(hue(), shade + kLighterColor);
-        rects.fill(Rect(left.left - 3, left.bottom - 1, right.right + 3, left.bottom), lighter);
+        list->fill(Rect(left.left - 3, left.bottom - 1, right.right + 3, left.bottom), lighter);
         const RgbColor darker = GetRGBTranslateColorShade(hue(), shade + kDarkerColor);
-        rects.fill(Rect(left.left - 3, left.bottom + 3, right.right + 3, left.bottom + 4), darker);
+        list->fill(Rect(left.left - 3, left.bottom + 3, right.right + 3, left.bottom + 4), darker);
     } else {
-        Rects rects;
         if (active()) {
             shade = LIGHT;
         } else if (!enabled()) {
@@ -1044,34 +1077,34 @@ void TabButton::draw(Point offset, InputMode) const {
         left.bottom += 7;
         right.bottom += 7;
         color = GetRGBTranslateColorShade(hue(), shade);
-        rects.fill(left, color);
-        rects.fill(right, color);
+        list->fill(left, color);
+        list->fill(right, color);
 
         const RgbColor lighter = GetRGBTranslateColorShade(hue(), shade + kLighterColor);
-        rects.fill(Rect(left.left, left.top, left.right - 1, left.top + 1), lighter);
-        rects.fill(Rect(left.left, left.top, left.left + 1, left.bottom - 5), lighter);
-        rects.fill(Rect(left.left - 3, left.bottom - 5, left.left + 1, left.bottom - 4), lighter);
-        rects.fill(Rect(right.left, right.top, right.right - 1, right.top + 1), lighter);
-        rects.fill(
+        list->fill(Rect(left.left, left.top, left.right - 1, left.top + 1), lighter);
+        list->fill(Rect(left.left, left.top, left.left + 1, left.bottom - 5), lighter);
+        list->fill(Rect(left.left - 3, left.bottom - 5, left.left + 1, left.bottom - 4), lighter);
+        list->fill(Rect(right.left, right.top, right.right - 1, right.top + 1), lighter);
+        list->fill(
                 Rect(right.right, right.bottom - 5, right.right + 3, right.bottom - 4), lighter);
-        rects.fill(Rect(right.left, right.top, right.left + 1, right.bottom - 1), lighter);
+        list->fill(Rect(right.left, right.top, right.left + 1, right.bottom - 1), lighter);
 
         const RgbColor darker = GetRGBTranslateColorShade(hue(), shade + kDarkerColor);
-        rects.fill(Rect(left.left - 3, left.bottom - 1, left.right, left.bottom), darker);
-        rects.fill(Rect(left.right - 1, left.top, left.right, left.bottom), darker);
-        rects.fill(Rect(right.right - 1, right.top, right.right, right.bottom - 4), darker);
-        rects.fill(Rect(right.left, right.bottom - 1, right.right + 3, right.bottom), darker);
+        list->fill(Rect(left.left - 3, left.bottom - 1, left.right, left.bottom), darker);
+        list->fill(Rect(left.right - 1, left.top, left.right, left.bottom), darker);
+        list->fill(Rect(right.right - 1, right.top, right.right, right.bottom - 4), darker);
+        list->fill(Rect(right.left, right.bottom - 1, right.right + 3, right.bottom), darker);
 
         Rect           uRect(left.left - 3, left.bottom - 4, left.right - 1, left.bottom - 1);
         const RgbColor color = GetRGBTranslateColorShade(hue(), shade);
-        rects.fill(uRect, color);
+        list->fill(uRect, color);
         Rect vRect(right.left + 1, right.bottom - 4, right.right + 3, right.bottom - 1);
-        rects.fill(vRect, color);
+        list->fill(vRect, color);
         uRect.top--;
         uRect.bottom++;
         uRect.left  = uRect.right + 1;
         uRect.right = vRect.left - 1;
-        rects.fill(uRect, RgbColor::black());
+        list->fill(uRect, RgbColor::black());
     }
 
     if (key() == Key::NONE) {
@@ -1091,7 +1124,7 @@ void TabButton::draw(Point offset, InputMode) const {
                      tRect.right - kInterfaceContentBuffer + 1,
                      tRect.bottom - kInterfaceContentBuffer + 1);
         color = GetRGBTranslateColorShade(hue(), shade);
-        Rects().fill(uRect, color);
+        list->fill(uRect, color);
 
         if (!on()) {
             if (active()) {
@@ -1109,7 +1142,7 @@ void TabButton::draw(Point offset, InputMode) const {
         swidth            = GetInterfaceStringWidth(s, style());
         swidth            = tRect.left + (tRect.right - tRect.left) / 2 - swidth / 2;
         sheight           = GetInterfaceFontAscent(style()) + kInterfaceTextVBuffer + tRect.top;
-        DrawInterfaceString(Point(swidth, sheight), s, style(), color);
+        DrawInterfaceString(list, Point(swidth, sheight), s, style(), color);
     } else {
         // draw the key code
         if (on()) {
@@ -1127,7 +1160,7 @@ void TabButton::draw(Point offset, InputMode) const {
                 tRect.left + kInterfaceContentBuffer, tRect.top + kInterfaceContentBuffer,
                 tRect.left + kInterfaceContentBuffer + swidth + kInterfaceTextHBuffer * 2 + 1,
                 tRect.bottom - kInterfaceContentBuffer + 1);
-        mDrawPuffUpRect(Rects(), uRect, hue(), shade);
+        mDrawPuffUpRect(list, uRect, hue(), shade);
 
         if (on()) {
             shade = MEDIUM;
@@ -1141,7 +1174,7 @@ void TabButton::draw(Point offset, InputMode) const {
                 tRect.top + kInterfaceContentBuffer, tRect.right - kInterfaceContentBuffer + 1,
                 tRect.bottom - kInterfaceContentBuffer + 1);
         color = GetRGBTranslateColorShade(hue(), shade);
-        Rects().fill(vRect, color);
+        list->fill(vRect, color);
 
         swidth = GetInterfaceStringWidth(s, style());
         swidth = uRect.left + (uRect.right - uRect.left) / 2 - swidth / 2;
@@ -1152,7 +1185,8 @@ void TabButton::draw(Point offset, InputMode) const {
         }
 
         DrawInterfaceString(
-                Point(swidth, uRect.top + GetInterfaceFontAscent(style())), s, style(), color);
+                list, Point(swidth, uRect.top + GetInterfaceFontAscent(style())), s, style(),
+                color);
 
         // draw the button title
         if (!on()) {
@@ -1172,7 +1206,7 @@ void TabButton::draw(Point offset, InputMode) const {
             swidth            = GetInterfaceStringWidth(s, style());
             swidth            = uRect.right + (tRect.right - uRect.right) / 2 - swidth / 2;
             sheight = GetInterfaceFontAscent(style()) + kInterfaceTextVBuffer + tRect.top;
-            DrawInterfaceString(Point(swidth, sheight), s, style(), color);
+            DrawInterfaceString(list, Point(swidth, sheight), s, style(), color);
         }
     }
 }
@@ -1247,8 +1281,7 @@ Widget* TabBox::accept_button(Gamepad::Button which) {
     return nullptr;
 }
 
-void TabBox::draw(Point offset, InputMode mode) const {
-    Rects          rects;
+void TabBox::record(DisplayList* list, Point offset, InputMode) const {
     Rect           uRect;
     int16_t        vcenter, h_border = kInterfaceSmallHBorder;
     uint8_t        shade;
@@ -1271,30 +1304,30 @@ void TabBox::draw(Point offset, InputMode mode) const {
     // top border
     shade              = MEDIUM;
     const RgbColor rgb = GetRGBTranslateColorShade(color, shade);
-    rects.fill(Rect(outer.left, outer.top, r.left, r.top), rgb);
-    rects.fill(Rect(r.right, outer.top, outer.right, r.top), rgb);
-    rects.fill(Rect(r.left, outer.top, r.left + 6, outer.bottom), rgb);
-    rects.fill(Rect(r.right - top_right_border_size, outer.top, r.right, outer.bottom), rgb);
+    list->fill(Rect(outer.left, outer.top, r.left, r.top), rgb);
+    list->fill(Rect(r.right, outer.top, outer.right, r.top), rgb);
+    list->fill(Rect(r.left, outer.top, r.left + 6, outer.bottom), rgb);
+    list->fill(Rect(r.right - top_right_border_size, outer.top, r.right, outer.bottom), rgb);
 
     const RgbColor darker = GetRGBTranslateColorShade(color, shade + kDarkerColor);
-    rects.fill(Rect(outer.left, r.top, r.left + 1, r.top + 1), darker);
-    rects.fill(Rect(r.left, outer.bottom, r.left + 6, outer.bottom + 1), darker);
-    rects.fill(
+    list->fill(Rect(outer.left, r.top, r.left + 1, r.top + 1), darker);
+    list->fill(Rect(r.left, outer.bottom, r.left + 6, outer.bottom + 1), darker);
+    list->fill(
             Rect(r.right - top_right_border_size, outer.bottom, r.right + 1, outer.bottom + 1),
             darker);
-    rects.fill(Rect(r.right, r.top, outer.right + 1, r.top + 1), darker);
-    rects.fill(Rect(outer.right, outer.top, outer.right + 1, r.top), darker);
+    list->fill(Rect(r.right, r.top, outer.right + 1, r.top + 1), darker);
+    list->fill(Rect(outer.right, outer.top, outer.right + 1, r.top), darker);
 
     const RgbColor lighter = GetRGBTranslateColorShade(color, shade + kLighterColor);
-    rects.fill(Rect(outer.left, outer.top, outer.left + 1, r.top), lighter);
-    rects.fill(Rect(outer.left, outer.top, r.left + 6, outer.top + 1), lighter);
-    rects.fill(
+    list->fill(Rect(outer.left, outer.top, outer.left + 1, r.top), lighter);
+    list->fill(Rect(outer.left, outer.top, r.left + 6, outer.top + 1), lighter);
+    list->fill(
             Rect(r.right - top_right_border_size, outer.top, outer.right + 1, outer.top + 1),
             lighter);
 
     // bottom border
 
-    mDrawPuffUpBottomBorder(rects, r, color, DARK, h_border);
+    mDrawPuffUpBottomBorder(list, r, color, DARK, h_border);
 
     // main part left border
 
@@ -1303,25 +1336,28 @@ void TabBox::draw(Point offset, InputMode mode) const {
     uRect =
             Rect(outer.left, r.top + kInterfaceHTop, r.left + 1,
                  r.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(rects, uRect, color, DARKER);
+    mDrawPuffUpRect(list, uRect, color, DARKER);
 
     uRect =
             Rect(outer.left, r.bottom - vcenter + kInterfaceVLipHeight, r.left + 1,
                  r.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(rects, uRect, color, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, color, VERY_DARK);
 
     // right border
 
     uRect =
             Rect(r.right, r.top + kInterfaceHTop, outer.right + 1,
                  r.top + vcenter - kInterfaceVLipHeight + 1);
-    mDrawPuffUpRect(rects, uRect, color, DARKER);
+    mDrawPuffUpRect(list, uRect, color, DARKER);
 
     uRect =
             Rect(r.right, r.bottom - vcenter + kInterfaceVLipHeight, outer.right + 1,
                  r.bottom - kInterfaceHTop + 1);
-    mDrawPuffUpRect(rects, uRect, color, VERY_DARK);
+    mDrawPuffUpRect(list, uRect, color, VERY_DARK);
+}
 
+void TabBox::draw(Point offset, InputMode mode) const {
+    Widget::draw(offset, mode);
     for (const auto& tab : _tabs) {
         tab->draw(offset, mode);
     }
@@ -18,6 +18,7 @@
 
 #include "video/driver.hpp"
 
+#include "drawing/display-list.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 
@@ -34,6 +35,14 @@ VideoDriver::~VideoDriver() { sys.video = NULL; }
 
 Texture::Impl::~Impl() {}
 
+void VideoDriver::fill_rects(const Rect* rects, const RgbColor* colors, size_t count) {
+    begin_rects();
+    for (size_t i = 0; i < count; ++i) {
+        batch_rect(rects[i], colors[i]);
+    }
+    end_rects();
+}
+
 TextReceiver::~TextReceiver() { sys.video->stop_editing(this); }
 
 Points::Points() { sys.video->begin_points(); }
@@ -52,12 +61,22 @@ void Lines::draw(const Point& from, const Point& to, const RgbColor& color) cons
     sys.video->batch_line(from, to, color);
 }
 
-Rects::Rects() { sys.video->begin_rects(); }
+Rects::Rects() : _list(nullptr) { sys.video->begin_rects(); }
 
-Rects::~Rects() { sys.video->end_rects(); }
+Rects::Rects(DisplayList* list) : _list(list) {}
+
+Rects::~Rects() {
+    if (!_list) {
+        sys.video->end_rects();
+    }
+}
 
 void Rects::fill(const Rect& rect, const RgbColor& color) const {
-    sys.video->batch_rect(rect, color);
+    if (_list) {
+        _list->fill(rect, color);
+    } else {
+        sys.video->batch_rect(rect, color);
+    }
 }
 
 Quads::Quads(const Texture& sprite) : _sprite(sprite) { _sprite._impl->begin_quads(); }
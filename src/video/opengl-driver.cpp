@@ -28,6 +28,8 @@
 #include "drawing/shapes.hpp"
 #include "game/globals.hpp"
 #include "game/time.hpp"
+#include "lang/memory.hpp"
+#include "lang/trace.hpp"
 #include "math/geometry.hpp"
 #include "math/random.hpp"
 #include "ui/card.hpp"
@@ -202,7 +204,8 @@ class OpenGlTextureImpl : public Texture::Impl {
               _size(image.size()),
               _scale(scale),
               _uniforms(uniforms),
-              _vbuf(vbuf) {
+              _vbuf(vbuf),
+              _charge(memory::TEXTURES) {
         glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -226,6 +229,7 @@ class OpenGlTextureImpl : public Texture::Impl {
         glTexImage2D(
                 GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA, type,
                 copy.bytes());
+        _charge.reset(static_cast<int64_t>(size.width) * size.height * sizeof(RgbColor));
     }
 
     virtual pn::string_view name() const { return _name; }
@@ -308,57 +312,79 @@ class OpenGlTextureImpl : public Texture::Impl {
         glDisableVertexAttribArray(0);
     }
 
+    // Quads are collected between begin_quads() and end_quads(), then drawn with one upload and
+    // one draw call, as two triangles each.  A run of text is a single draw instead of one per
+    // glyph.
     virtual void begin_quads() const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+        _quad_vertices.clear();
+        _quad_colors.clear();
+        _quad_tex_coords.clear();
     }
 
-    virtual void end_quads() const {}
+    virtual void end_quads() const {
+        if (_quad_vertices.empty()) {
+            return;
+        }
+        _uniforms.color_mode.set(TINT_SPRITE_MODE);
 
-    virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
         glEnableVertexAttribArray(0);
         glEnableVertexAttribArray(1);
         glEnableVertexAttribArray(2);
 
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(dest.left),   GLshort(dest.top),   GLshort(dest.left),
-                GLshort(dest.bottom), GLshort(dest.right), GLshort(dest.bottom),
-                GLshort(dest.right),  GLshort(dest.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quad_vertices.size() * sizeof(GLshort), _quad_vertices.data(),
+                GL_STREAM_DRAW);
         glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
 
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quad_colors.size() * sizeof(GLubyte), _quad_colors.data(),
+                GL_STREAM_DRAW);
         glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
 
-        Rect texture_rect = source;
-        texture_rect.scale(_scale, _scale);
-        texture_rect.offset(1, 1);
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        GLshort tex_coords[] = {
-                GLshort(texture_rect.left),  GLshort(texture_rect.top),
-                GLshort(texture_rect.left),  GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quad_tex_coords.size() * sizeof(GLshort),
+                _quad_tex_coords.data(), GL_STREAM_DRAW);
         glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+        glDrawArrays(GL_TRIANGLES, 0, _quad_vertices.size() / 2);
 
         glDisableVertexAttribArray(2);
         glDisableVertexAttribArray(1);
         glDisableVertexAttribArray(0);
+
+        _quad_vertices.clear();
+        _quad_colors.clear();
+        _quad_tex_coords.clear();
+    }
+
+    // Split along the same diagonal as draw_internal()'s fan, so the pixels covered are the same.
+    virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        _quad_vertices.insert(
+                _quad_vertices.end(),
+                {GLshort(dest.left), GLshort(dest.top), GLshort(dest.left), GLshort(dest.bottom),
+                 GLshort(dest.right), GLshort(dest.bottom), GLshort(dest.left), GLshort(dest.top),
+                 GLshort(dest.right), GLshort(dest.bottom), GLshort(dest.right),
+                 GLshort(dest.top)});
+        for (int i = 0; i < 6; ++i) {
+            _quad_colors.insert(_quad_colors.end(), {tint.red, tint.green, tint.blue, tint.alpha});
+        }
+
+        Rect texture_rect = source;
+        texture_rect.scale(_scale, _scale);
+        texture_rect.offset(1, 1);
+        _quad_tex_coords.insert(
+                _quad_tex_coords.end(),
+                {GLshort(texture_rect.left), GLshort(texture_rect.top), GLshort(texture_rect.left),
+                 GLshort(texture_rect.bottom), GLshort(texture_rect.right),
+                 GLshort(texture_rect.bottom), GLshort(texture_rect.left),
+                 GLshort(texture_rect.top), GLshort(texture_rect.right),
+                 GLshort(texture_rect.bottom), GLshort(texture_rect.right),
+                 GLshort(texture_rect.top)});
     }
 
     struct Texture {
@@ -376,6 +402,10 @@ class OpenGlTextureImpl : public Texture::Impl {
     int                                _scale;
     const OpenGlVideoDriver::Uniforms& _uniforms;
     GLuint*                            _vbuf;
+    memory::Charge                     _charge;
+    mutable std::vector<GLshort>       _quad_vertices;    // x, y
+    mutable std::vector<GLubyte>       _quad_colors;      // r, g, b, a
+    mutable std::vector<GLshort>       _quad_tex_coords;  // x, y
 };
 
 }  // namespace
@@ -420,6 +450,25 @@ void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
 
 void OpenGlVideoDriver::end_rects() {}
 
+// Two triangles per rect, split along the same diagonal as batch_rect()'s fan, so the pixels
+// covered are the same.
+void OpenGlVideoDriver::fill_rects(const Rect* rects, const RgbColor* colors, size_t count) {
+    _uniforms.color_mode.set(FILL_MODE);
+    for (size_t i = 0; i < count; ++i) {
+        const Rect&     r = rects[i];
+        const RgbColor& c = colors[i];
+        _batch_vertices.insert(
+                _batch_vertices.end(),
+                {GLfloat(r.right), GLfloat(r.top), GLfloat(r.left), GLfloat(r.top),
+                 GLfloat(r.left), GLfloat(r.bottom), GLfloat(r.right), GLfloat(r.top),
+                 GLfloat(r.left), GLfloat(r.bottom), GLfloat(r.right), GLfloat(r.bottom)});
+        for (int j = 0; j < 6; ++j) {
+            _batch_colors.insert(_batch_colors.end(), {c.red, c.green, c.blue, c.alpha});
+        }
+    }
+    draw_batch(GL_TRIANGLES);
+}
+
 void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
     _uniforms.color_mode.set(DITHER_MODE);
     batch_rect(rect, color);
@@ -427,31 +476,11 @@ void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
 
 void OpenGlVideoDriver::begin_points() { _uniforms.color_mode.set(FILL_MODE); }
 
-void OpenGlVideoDriver::end_points() {}
+void OpenGlVideoDriver::end_points() { draw_batch(GL_POINTS); }
 
 void OpenGlVideoDriver::batch_point(const Point& at, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {GLfloat(at.h + 0.5), GLfloat(at.v + 0.5)};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,
-            color.green,
-            color.blue,
-            color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_POINTS, 0, 1);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    _batch_vertices.insert(_batch_vertices.end(), {GLfloat(at.h + 0.5), GLfloat(at.v + 0.5)});
+    _batch_colors.insert(_batch_colors.end(), {color.red, color.green, color.blue, color.alpha});
 }
 
 void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
@@ -462,7 +491,7 @@ void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
 
 void OpenGlVideoDriver::begin_lines() { _uniforms.color_mode.set(FILL_MODE); }
 
-void OpenGlVideoDriver::end_lines() {}
+void OpenGlVideoDriver::end_lines() { draw_batch(GL_LINES); }
 
 void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const RgbColor& color) {
     //
@@ -497,26 +526,39 @@ void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const Rgb
         y2 += 1.0f;
     }
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
+    _batch_vertices.insert(_batch_vertices.end(), {x1, y1, x2, y2});
+    _batch_colors.insert(
+            _batch_colors.end(), {color.red, color.green, color.blue, color.alpha, color.red,
+                                  color.green, color.blue, color.alpha});
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {x1, y1, x2, y2};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+// Points and lines are collected between begin_*() and end_*(), then drawn with one upload and
+// one draw call.  A single draw call rasterizes primitives in order, so this looks exactly like
+// drawing each one separately; the starfield and sparks alone used to take hundreds of calls.
+void OpenGlVideoDriver::draw_batch(uint32_t mode) {
+    if (!_batch_vertices.empty()) {
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red, color.green, color.blue, color.alpha,
-            color.red, color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
+        glBufferData(
+                GL_ARRAY_BUFFER, _batch_vertices.size() * sizeof(GLfloat), _batch_vertices.data(),
+                GL_STREAM_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-    glDrawArrays(GL_LINES, 0, 2);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
+        glBufferData(
+                GL_ARRAY_BUFFER, _batch_colors.size() * sizeof(GLubyte), _batch_colors.data(),
+                GL_STREAM_DRAW);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
 
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+        glDrawArrays(mode, 0, _batch_vertices.size() / 2);
+
+        glDisableVertexAttribArray(1);
+        glDisableVertexAttribArray(0);
+    }
+    _batch_vertices.clear();
+    _batch_colors.clear();
 }
 
 void OpenGlVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
@@ -660,8 +702,12 @@ void OpenGlVideoDriver::MainLoop::draw() {
         return;
     }
 
-    glClear(GL_COLOR_BUFFER_BIT);
-    glViewport(0, 0, _driver.viewport_size().width, _driver.viewport_size().height);
+    ANTARES_TRACE_SCOPE("frame");
+    {
+        ANTARES_TRACE_SCOPE("begin frame");
+        glClear(GL_COLOR_BUFFER_BIT);
+        glViewport(0, 0, _driver.viewport_size().width, _driver.viewport_size().height);
+    }
 
     auto screen = _driver.screen_size();
     _driver._uniforms.screen.set({screen.width * 1.0f, screen.height * 1.0f});
@@ -674,6 +720,7 @@ void OpenGlVideoDriver::MainLoop::draw() {
 
     _stack.top()->draw();
 
+    ANTARES_TRACE_SCOPE("end frame");
     glFinish();
 }
 
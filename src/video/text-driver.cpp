@@ -29,6 +29,7 @@
 #include "game/globals.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
+#include "lang/trace.hpp"
 #include "math/geometry.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
@@ -148,6 +149,7 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
     }
 
     void draw() {
+        ANTARES_TRACE_SCOPE("frame");
         _driver._log.clear();
         _driver._last_args.clear();
         _stack.top()->draw();